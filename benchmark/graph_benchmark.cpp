@@ -0,0 +1,423 @@
+#include "gdwg/edge_list.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/interned_graph.hpp"
+
+#include "graph_generators.hpp"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Every benchmark is registered once per node type and graph shape, over edge counts from 10^2 to
+// 10^6, with a complexity fit so regressions show up as a change of curve rather than a constant.
+//
+// Point operations are timed over a batch of `batch` calls against a graph of the given size. Any
+// work needed to restore the graph between iterations runs with the timer paused.
+
+namespace {
+	using gdwg::benchmarks::shape;
+
+	constexpr auto batch = std::size_t{64};
+	// Larger than any generated weight, so inserted weights never collide with existing ones.
+	constexpr auto fresh_weight = 2'000'000;
+
+	// Discards everything written to it, so operator<< is measured without any I/O.
+	class null_buffer : public std::streambuf {
+	protected:
+		auto overflow(int_type c) -> int_type override {
+			return c;
+		}
+		auto xsputn(char const*, std::streamsize n) -> std::streamsize override {
+			return n;
+		}
+	};
+
+	// G is the graph under test; interned_graph is measured through the same operations.
+	template<typename N, typename G = gdwg::graph<N, int>>
+	class fixture {
+	public:
+		fixture(benchmark::State const& state, shape s)
+		: edges_(static_cast<std::size_t>(state.range(0)))
+		, nodes_(gdwg::benchmarks::node_count(s, edges_))
+		, graph(gdwg::benchmarks::generate_graph<N>(s, edges_)) {}
+
+		// The k-th node that the generated graph does not hold.
+		[[nodiscard]] auto fresh(std::size_t k) const -> N {
+			return gdwg::benchmarks::make_node<N>(nodes_ + k);
+		}
+
+		// An existing node, spread across the whole node range.
+		[[nodiscard]] auto existing(std::size_t k) const -> N {
+			return gdwg::benchmarks::make_node<N>((k * 7919) % nodes_);
+		}
+
+		auto finish(benchmark::State& state, std::size_t items_per_iteration) const -> void {
+			state.SetComplexityN(static_cast<benchmark::IterationCount>(edges_));
+			state.SetItemsProcessed(state.iterations()
+			                        * static_cast<benchmark::IterationCount>(items_per_iteration));
+		}
+
+	private:
+		std::size_t edges_;
+		std::size_t nodes_;
+
+	public:
+		G graph;
+	};
+
+	// ======================================
+	//              Whole graph
+	// ======================================
+	template<typename N>
+	auto construct(benchmark::State& state, shape s) -> void {
+		auto const values =
+		   gdwg::benchmarks::generate_edges<N>(s, static_cast<std::size_t>(state.range(0)));
+		for (auto _ : state) {
+			auto g = gdwg::graph<N, int>(values.begin(), values.end());
+			benchmark::DoNotOptimize(g);
+		}
+		state.SetComplexityN(state.range(0));
+	}
+
+	// Loads a generated edge list file with the given number of worker threads. The file is written
+	// before timing starts; below 64 KiB per worker a load uses fewer workers, so the smaller
+	// sizes run on one thread whatever they are given.
+	template<typename N>
+	auto load_edge_list(benchmark::State& state, shape s, std::size_t threads) -> void {
+		auto const edges = static_cast<std::size_t>(state.range(0));
+		auto const path = std::filesystem::temp_directory_path()
+		                  / fmt::format("gdwg_benchmark_{}_{}_{}.txt",
+		                                gdwg::benchmarks::to_string(s),
+		                                edges,
+		                                threads);
+		{
+			auto file = std::ofstream(path);
+			for (auto const& [from, to, weight] : gdwg::benchmarks::generate_edges<N>(s, edges)) {
+				file << from << ' ' << to << ' ' << weight << '\n';
+			}
+		}
+		auto const bytes = static_cast<std::int64_t>(std::filesystem::file_size(path));
+		auto options = gdwg::edge_list_options();
+		options.threads = threads;
+		for (auto _ : state) {
+			auto g = gdwg::load_edge_list<N, int>(path, options);
+			benchmark::DoNotOptimize(g);
+		}
+		std::filesystem::remove(path);
+		state.SetComplexityN(state.range(0));
+		state.SetBytesProcessed(state.iterations() * bytes);
+	}
+
+	template<typename N>
+	auto copy(benchmark::State& state, shape s) -> void {
+		auto f = fixture<N>(state, s);
+		for (auto _ : state) {
+			auto g = f.graph;
+			benchmark::DoNotOptimize(g);
+		}
+		f.finish(state, 1);
+	}
+
+	// Copy-assigns over a graph of the same size, so the old contents are torn down each time too.
+	template<typename N>
+	auto copy_assign(benchmark::State& state, shape s) -> void {
+		auto f = fixture<N>(state, s);
+		auto g = f.graph;
+		for (auto _ : state) {
+			g = f.graph;
+			benchmark::DoNotOptimize(g);
+		}
+		f.finish(state, 1);
+	}
+
+	template<typename N>
+	auto equality(benchmark::State& state, shape s) -> void {
+		auto f = fixture<N>(state, s);
+		auto const other = f.graph;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(f.graph == other);
+		}
+		f.finish(state, 1);
+	}
+
+	template<typename N>
+	auto output(benchmark::State& state, shape s) -> void {
+		auto f = fixture<N>(state, s);
+		auto buffer = null_buffer();
+		auto os = std::ostream(&buffer);
+		for (auto _ : state) {
+			os << f.graph;
+		}
+		f.finish(state, 1);
+	}
+
+	// ======================================
+	//              Modifiers
+	// ======================================
+	template<typename N>
+	auto insert_node(benchmark::State& state, shape s) -> void {
+		auto f = fixture<N>(state, s);
+		for (auto _ : state) {
+			for (auto k = std::size_t{0}; k < batch; ++k) {
+				benchmark::DoNotOptimize(f.graph.insert_node(f.fresh(k)));
+			}
+			state.PauseTiming();
+			for (auto k = std::size_t{0}; k < batch; ++k) {
+				f.graph.erase_node(f.fresh(k));
+			}
+			state.ResumeTiming();
+		}
+		f.finish(state, batch);
+	}
+
+	template<typename N, typename G = gdwg::graph<N, int>>
+	auto insert_edge(benchmark::State& state, shape s) -> void {
+		auto f = fixture<N, G>(state, s);
+		for (auto _ : state) {
+			for (auto k = std::size_t{0}; k < batch; ++k) {
+				auto const weight = fresh_weight + static_cast<int>(k);
+				benchmark::DoNotOptimize(f.graph.insert_edge(f.existing(k), f.existing(k + 1), weight));
+			}
+			state.PauseTiming();
+			for (auto k = std::size_t{0}; k < batch; ++k) {
+				f.graph.erase_edge(f.existing(k), f.existing(k + 1), fresh_weight + static_cast<int>(k));
+			}
+			state.ResumeTiming();
+		}
+		f.finish(state, batch);
+	}
+
+	template<typename N, typename G = gdwg::graph<N, int>>
+	auto erase_edge_value(benchmark::State& state, shape s) -> void {
+		auto f = fixture<N, G>(state, s);
+		for (auto _ : state) {
+			state.PauseTiming();
+			for (auto k = std::size_t{0}; k < batch; ++k) {
+				f.graph.insert_edge(f.existing(k), f.existing(k + 1), fresh_weight + static_cast<int>(k));
+			}
+			state.ResumeTiming();
+			for (auto k = std::size_t{0}; k < batch; ++k) {
+				auto const weight = fresh_weight + static_cast<int>(k);
+				benchmark::DoNotOptimize(f.graph.erase_edge(f.existing(k), f.existing(k + 1), weight));
+			}
+		}
+		f.finish(state, batch);
+	}
+
+	// Every target edge runs to its own fresh node, so no two share a (src, dst) pair: erasing one
+	// weight of a pair invalidates the iterators to the pair's other weights.
+	template<typename N>
+	auto erase_edge_iterator(benchmark::State& state, shape s) -> void {
+		auto f = fixture<N>(state, s);
+		for (auto k = std::size_t{0}; k < batch; ++k) {
+			f.graph.insert_node(f.fresh(k));
+		}
+		auto targets = std::vector<typename gdwg::graph<N, int>::iterator>();
+		targets.reserve(batch);
+		for (auto _ : state) {
+			state.PauseTiming();
+			targets.clear();
+			for (auto k = std::size_t{0}; k < batch; ++k) {
+				auto const weight = fresh_weight + static_cast<int>(k);
+				f.graph.insert_edge(f.existing(k), f.fresh(k), weight);
+			}
+			for (auto k = std::size_t{0}; k < batch; ++k) {
+				auto const weight = fresh_weight + static_cast<int>(k);
+				targets.push_back(f.graph.find(f.existing(k), f.fresh(k), weight));
+			}
+			state.ResumeTiming();
+			for (auto const& it : targets) {
+				benchmark::DoNotOptimize(f.graph.erase_edge(it));
+			}
+		}
+		f.finish(state, batch);
+	}
+
+	// Erases a run of `batch` parallel edges with erase_edge(first, last).
+	template<typename N>
+	auto erase_edge_range(benchmark::State& state, shape s) -> void {
+		auto f = fixture<N>(state, s);
+		auto const src = f.existing(0);
+		auto const dst = f.existing(1);
+		for (auto _ : state) {
+			state.PauseTiming();
+			for (auto k = std::size_t{0}; k < batch; ++k) {
+				f.graph.insert_edge(src, dst, fresh_weight + static_cast<int>(k));
+			}
+			auto first = f.graph.find(src, dst, fresh_weight);
+			auto last = std::next(f.graph.find(src, dst, fresh_weight + static_cast<int>(batch) - 1));
+			state.ResumeTiming();
+			benchmark::DoNotOptimize(f.graph.erase_edge(first, last));
+		}
+		f.finish(state, batch);
+	}
+
+	// Erases fresh nodes that each have four outgoing and four incoming edges.
+	template<typename N>
+	auto erase_node(benchmark::State& state, shape s) -> void {
+		auto f = fixture<N>(state, s);
+		for (auto _ : state) {
+			state.PauseTiming();
+			for (auto k = std::size_t{0}; k < batch; ++k) {
+				f.graph.insert_node(f.fresh(k));
+				for (auto j = std::size_t{0}; j < 4; ++j) {
+					f.graph.insert_edge(f.fresh(k), f.existing(k + j), static_cast<int>(j));
+					f.graph.insert_edge(f.existing(k + j), f.fresh(k), static_cast<int>(j));
+				}
+			}
+			state.ResumeTiming();
+			for (auto k = std::size_t{0}; k < batch; ++k) {
+				benchmark::DoNotOptimize(f.graph.erase_node(f.fresh(k)));
+			}
+		}
+		f.finish(state, batch);
+	}
+
+	// Merges pairs of fresh nodes that each have four outgoing and four incoming edges.
+	template<typename N>
+	auto merge_replace_node(benchmark::State& state, shape s) -> void {
+		auto f = fixture<N>(state, s);
+		for (auto _ : state) {
+			state.PauseTiming();
+			for (auto k = std::size_t{0}; k < 2 * batch; ++k) {
+				f.graph.insert_node(f.fresh(k));
+				for (auto j = std::size_t{0}; j < 4; ++j) {
+					f.graph.insert_edge(f.fresh(k), f.existing(k + j), static_cast<int>(j));
+					f.graph.insert_edge(f.existing(k + j), f.fresh(k), static_cast<int>(j));
+				}
+			}
+			state.ResumeTiming();
+			for (auto k = std::size_t{0}; k < batch; ++k) {
+				f.graph.merge_replace_node(f.fresh(2 * k), f.fresh(2 * k + 1));
+			}
+			state.PauseTiming();
+			for (auto k = std::size_t{0}; k < batch; ++k) {
+				f.graph.erase_node(f.fresh(2 * k + 1));
+			}
+			state.ResumeTiming();
+		}
+		f.finish(state, batch);
+	}
+
+	// ======================================
+	//              Accessors
+	// ======================================
+	template<typename N, typename G = gdwg::graph<N, int>>
+	auto find(benchmark::State& state, shape s) -> void {
+		auto f = fixture<N, G>(state, s);
+		auto const values =
+		   gdwg::benchmarks::generate_edges<N>(s, static_cast<std::size_t>(state.range(0)));
+		auto queries = std::vector<typename gdwg::graph<N, int>::value_type>();
+		for (auto k = std::size_t{0}; k < batch; ++k) {
+			queries.push_back(values[(k * 7919) % values.size()]);
+		}
+		for (auto _ : state) {
+			for (auto const& [from, to, weight] : queries) {
+				benchmark::DoNotOptimize(f.graph.find(from, to, weight));
+			}
+		}
+		f.finish(state, batch);
+	}
+
+	template<typename N, typename G = gdwg::graph<N, int>>
+	auto connections(benchmark::State& state, shape s) -> void {
+		auto f = fixture<N, G>(state, s);
+		for (auto _ : state) {
+			for (auto k = std::size_t{0}; k < batch; ++k) {
+				benchmark::DoNotOptimize(f.graph.connections(f.existing(k)));
+			}
+		}
+		f.finish(state, batch);
+	}
+
+	// ======================================
+	//              Registration
+	// ======================================
+	using benchmark_function = void (*)(benchmark::State&, shape);
+
+	auto register_operation(std::string_view operation,
+	                        std::string_view type,
+	                        benchmark_function function) -> void {
+		for (auto s : gdwg::benchmarks::all_shapes) {
+			auto const name = fmt::format("{}<{}>/{}", operation, type, gdwg::benchmarks::to_string(s));
+			benchmark::RegisterBenchmark(name.c_str(), function, s)
+			   ->RangeMultiplier(10)
+			   ->Range(100, 1'000'000)
+			   ->Complexity()
+			   ->Unit(benchmark::kMicrosecond);
+		}
+	}
+
+	// load_edge_list at 1, 2 and 4 worker threads and one per hardware thread, each thread count
+	// fitted as its own family so the scaling can be read off side by side.
+	template<typename N>
+	auto register_load_edge_list(std::string_view type) -> void {
+		auto thread_counts = std::vector<std::size_t>{1, 2, 4};
+		auto const hardware = gdwg::detail::hardware_threads();
+		if (std::find(thread_counts.begin(), thread_counts.end(), hardware) == thread_counts.end()) {
+			thread_counts.push_back(hardware);
+		}
+		for (auto s : gdwg::benchmarks::all_shapes) {
+			for (auto threads : thread_counts) {
+				auto const name = fmt::format("load_edge_list<{}>/{}/{}_threads",
+				                              type,
+				                              gdwg::benchmarks::to_string(s),
+				                              threads);
+				// The workers' time isn't the calling thread's, so the load is timed by the wall clock.
+				benchmark::RegisterBenchmark(name.c_str(), load_edge_list<N>, s, threads)
+				   ->RangeMultiplier(10)
+				   ->Range(100, 1'000'000)
+				   ->UseRealTime()
+				   ->Complexity()
+				   ->Unit(benchmark::kMicrosecond);
+			}
+		}
+	}
+
+	template<typename N>
+	auto register_node_type(std::string_view type) -> void {
+		register_operation("construct", type, construct<N>);
+		register_operation("insert_node", type, insert_node<N>);
+		register_operation("insert_edge", type, insert_edge<N>);
+		register_operation("erase_node", type, erase_node<N>);
+		register_operation("erase_edge_value", type, erase_edge_value<N>);
+		register_operation("erase_edge_iterator", type, erase_edge_iterator<N>);
+		register_operation("erase_edge_range", type, erase_edge_range<N>);
+		register_operation("merge_replace_node", type, merge_replace_node<N>);
+		register_operation("find", type, find<N>);
+		register_operation("connections", type, connections<N>);
+		register_operation("copy", type, copy<N>);
+		register_operation("copy_assign", type, copy_assign<N>);
+		register_operation("equality", type, equality<N>);
+		register_operation("output", type, output<N>);
+		register_load_edge_list<N>(type);
+	}
+
+	// The string-keyed operations again on an interned_graph, to compare against graph's.
+	auto register_interned() -> void {
+		using interned = gdwg::interned_graph<std::string, int>;
+		register_operation("insert_edge", "interned_string", insert_edge<std::string, interned>);
+		register_operation("erase_edge_value",
+		                   "interned_string",
+		                   erase_edge_value<std::string, interned>);
+		register_operation("find", "interned_string", find<std::string, interned>);
+		register_operation("connections", "interned_string", connections<std::string, interned>);
+	}
+
+	auto const registered = [] {
+		register_node_type<int>("int");
+		register_node_type<std::string>("string");
+		register_interned();
+		return true;
+	}();
+} // namespace
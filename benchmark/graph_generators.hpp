@@ -0,0 +1,129 @@
+#ifndef GDWG_BENCHMARK_GRAPH_GENERATORS_HPP
+#define GDWG_BENCHMARK_GRAPH_GENERATORS_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace gdwg::benchmarks {
+	// The synthetic graph families every benchmark is run over.
+	enum class shape {
+		// Uniformly random endpoints with an average out-degree of four.
+		sparse,
+		// sqrt(E) nodes where almost every ordered pair is connected.
+		dense,
+		// Endpoints drawn from a heavily skewed distribution, so a few hubs own most edges.
+		power_law,
+		// Few node pairs that each carry many parallel weights.
+		multigraph,
+	};
+
+	inline constexpr auto all_shapes =
+	   std::array{shape::sparse, shape::dense, shape::power_law, shape::multigraph};
+
+	inline auto to_string(shape s) -> std::string_view {
+		switch (s) {
+		case shape::sparse: return "sparse";
+		case shape::dense: return "dense";
+		case shape::power_law: return "power_law";
+		case shape::multigraph: return "multigraph";
+		}
+		return "unknown";
+	}
+
+	template<typename N>
+	auto make_node(std::size_t i) -> N {
+		if constexpr (std::is_same_v<N, std::string>) {
+			return "node_" + std::to_string(i);
+		}
+		else {
+			return static_cast<N>(i);
+		}
+	}
+
+	// How many distinct nodes a graph of the given shape and edge count is built over.
+	inline auto node_count(shape s, std::size_t edges) -> std::size_t {
+		switch (s) {
+		case shape::sparse:
+		case shape::power_law: return std::max<std::size_t>(2, edges / 4);
+		case shape::dense:
+			return std::max<std::size_t>(2, static_cast<std::size_t>(std::ceil(std::sqrt(edges))) + 1);
+		case shape::multigraph:
+			return std::max<std::size_t>(2, static_cast<std::size_t>(std::sqrt(edges / 64.0)) + 1);
+		}
+		return 2;
+	}
+
+	// Generates `edges` (src, dst, weight) triples of the given shape. The output is deterministic
+	// for a given seed so runs are comparable.
+	template<typename N>
+	auto generate_edges(shape s, std::size_t edges, std::uint64_t seed = 6771)
+	   -> std::vector<typename graph<N, int>::value_type> {
+		auto engine = std::mt19937_64(seed);
+		auto const nodes = node_count(s, edges);
+		auto uniform = std::uniform_int_distribution<std::size_t>(0, nodes - 1);
+		auto unit = std::uniform_real_distribution<double>(0.0, 1.0);
+		auto weight = std::uniform_int_distribution<int>(-1'000'000, 1'000'000);
+		auto skewed = [&] {
+			auto const u = unit(engine);
+			return std::min(nodes - 1, static_cast<std::size_t>(static_cast<double>(nodes) * u * u * u));
+		};
+
+		auto result = std::vector<typename graph<N, int>::value_type>();
+		result.reserve(edges);
+		for (auto i = std::size_t{0}; i < edges; ++i) {
+			auto src = std::size_t{0};
+			auto dst = std::size_t{0};
+			auto w = weight(engine);
+			switch (s) {
+			case shape::sparse:
+				src = uniform(engine);
+				dst = uniform(engine);
+				break;
+			case shape::dense:
+				src = i / nodes;
+				dst = i % nodes;
+				break;
+			case shape::power_law:
+				src = skewed();
+				dst = skewed();
+				break;
+			case shape::multigraph: {
+				// 64 parallel weights per pair; the index makes them distinct.
+				auto const pair = i / 64;
+				src = pair / nodes;
+				dst = pair % nodes;
+				w = static_cast<int>(i);
+				break;
+			}
+			}
+			result.push_back({make_node<N>(src), make_node<N>(dst), w});
+		}
+		return result;
+	}
+
+	// Builds a graph over every node of the shape, including ones no generated edge touches.
+	template<typename N>
+	auto generate_graph(shape s, std::size_t edges) -> graph<N, int> {
+		auto const values = generate_edges<N>(s, edges);
+		auto result = graph<N, int>();
+		for (auto i = std::size_t{0}; i < node_count(s, edges); ++i) {
+			result.insert_node(make_node<N>(i));
+		}
+		for (auto const& value : values) {
+			result.insert_edge(value.from, value.to, value.weight);
+		}
+		return result;
+	}
+} // namespace gdwg::benchmarks
+
+#endif // GDWG_BENCHMARK_GRAPH_GENERATORS_HPP
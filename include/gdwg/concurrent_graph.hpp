@@ -0,0 +1,186 @@
+#ifndef GDWG_CONCURRENT_GRAPH_HPP
+#define GDWG_CONCURRENT_GRAPH_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace gdwg {
+	// A graph shared between many reader threads and occasional writers.
+	//
+	// Readers call read() and get a snapshot: a consistent, immutable version of the graph that
+	// stays valid for as long as the snapshot lives, even past later updates or the
+	// concurrent_graph itself. Taking and releasing one is wait-free, a handful of atomic operations
+	// that never block on a writer.
+	//
+	// Writers call update() with a batch of mutations. The batch runs against a private copy of the
+	// latest version, which is then published for new readers. Each update copies the graph, so
+	// batch mutations rather than publishing them one at a time.
+	//
+	// Versions are reference counted by their snapshots. What needs care is the moment between a
+	// reader loading the current version and counting itself on it, since a writer may retire the
+	// version in between. That window is covered read-copy-update style: readers announce
+	// themselves under the current epoch, and a writer waits for the epochs active when it published
+	// to drain before dropping its own reference to the old version. The wait only ever covers
+	// readers inside that window, never snapshots being held.
+	template<concepts::regular N, concepts::regular E>
+	requires concepts::totally_ordered<N> //
+	   and concepts::totally_ordered<E> //
+
+	   class concurrent_graph {
+		struct version {
+			// Not an aggregate, so make_unique can build one on compilers without parenthesised
+			// aggregate initialisation.
+			version(graph<N, E> v, std::uint64_t n)
+			: value(std::move(v))
+			, number(n) {}
+
+			graph<N, E> value;
+			std::uint64_t number;
+			std::atomic<std::size_t> references = 1;
+		};
+
+		// Readers in the acquisition window are counted in stripes over separate cache lines, so
+		// concurrent readers rarely share one.
+		struct alignas(64) reader_count {
+			std::atomic<std::size_t> value = 0;
+		};
+		static constexpr auto stripes = std::size_t{16};
+
+		static auto release(version* v) noexcept -> void {
+			if (v != nullptr and v->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				delete v;
+			}
+		}
+
+	public:
+		// A pinned version of the graph. Move-only; the version is released on destruction.
+		class snapshot {
+		public:
+			snapshot(snapshot&& other) noexcept
+			: version_(std::exchange(other.version_, nullptr)) {}
+
+			auto operator=(snapshot&& other) noexcept -> snapshot& {
+				if (this != &other) {
+					release(std::exchange(version_, std::exchange(other.version_, nullptr)));
+				}
+				return *this;
+			}
+
+			snapshot(snapshot const&) = delete;
+			auto operator=(snapshot const&) -> snapshot& = delete;
+
+			~snapshot() {
+				release(version_);
+			}
+
+			auto operator*() const noexcept -> graph<N, E> const& {
+				return version_->value;
+			}
+
+			auto operator->() const noexcept -> graph<N, E> const* {
+				return &version_->value;
+			}
+
+			// The number of updates published before this version.
+			[[nodiscard]] auto version() const noexcept -> std::uint64_t {
+				return version_->number;
+			}
+
+		private:
+			typename concurrent_graph::version* version_;
+
+			friend class concurrent_graph;
+			explicit snapshot(typename concurrent_graph::version* v) noexcept
+			: version_(v) {}
+		};
+
+		// ======================================
+		//              Constructors
+		// ======================================
+		concurrent_graph()
+		: concurrent_graph(graph<N, E>()) {}
+
+		explicit concurrent_graph(graph<N, E> g)
+		: current_(new version{std::move(g), 0}) {}
+
+		concurrent_graph(concurrent_graph const&) = delete;
+		auto operator=(concurrent_graph const&) -> concurrent_graph& = delete;
+
+		~concurrent_graph() {
+			release(current_.load());
+		}
+
+		// ======================================
+		//              Readers
+		// ======================================
+		[[nodiscard]] auto read() const -> snapshot {
+			auto& count = counts_[epoch_.load() & 1][stripe()].value;
+			count.fetch_add(1);
+			auto* current = current_.load();
+			current->references.fetch_add(1, std::memory_order_relaxed);
+			count.fetch_sub(1, std::memory_order_release);
+			return snapshot(current);
+		}
+
+		// ======================================
+		//              Writers
+		// ======================================
+		// Runs f(graph<N, E>&) against a copy of the latest version and publishes the result. If f
+		// throws, nothing is published.
+		template<typename F>
+		requires std::is_invocable_v<F&, graph<N, E>&>
+		auto update(F&& f) -> void {
+			auto lock = std::lock_guard(writer_);
+			auto const* current = current_.load();
+			auto next = std::make_unique<version>(current->value, current->number + 1);
+			f(next->value);
+			publish(std::move(next));
+		}
+
+		// Publishes `g` as the next version without copying anything.
+		auto replace(graph<N, E> g) -> void {
+			auto lock = std::lock_guard(writer_);
+			auto const number = current_.load()->number + 1;
+			publish(std::make_unique<version>(std::move(g), number));
+		}
+
+	private:
+		std::atomic<version*> current_;
+		// A grace period flips the epoch's parity and waits for readers counted under the old one
+		// to drain, twice, after which no reader can still be between loading the old version and
+		// referencing it.
+		std::atomic<std::uint64_t> epoch_ = 0;
+		mutable std::array<std::array<reader_count, stripes>, 2> counts_;
+		std::mutex writer_;
+
+		static auto stripe() noexcept -> std::size_t {
+			static auto next = std::atomic<std::size_t>(0);
+			thread_local auto const assigned = next.fetch_add(1, std::memory_order_relaxed) % stripes;
+			return assigned;
+		}
+
+		auto publish(std::unique_ptr<version> next) -> void {
+			auto* old = current_.exchange(next.release());
+			for (auto phase = 0; phase < 2; ++phase) {
+				auto const parity = epoch_.fetch_add(1) & 1;
+				for (auto& count : counts_[parity]) {
+					while (count.value.load() != 0) {
+						std::this_thread::yield();
+					}
+				}
+			}
+			release(old);
+		}
+	};
+} // namespace gdwg
+
+#endif // GDWG_CONCURRENT_GRAPH_HPP
@@ -0,0 +1,279 @@
+#ifndef GDWG_EDGE_LIST_HPP
+#define GDWG_EDGE_LIST_HPP
+
+#include "gdwg/graph.hpp"
+#include "gdwg/graph_algorithms.hpp"
+#include "gdwg/graph_reader.hpp"
+#include "gdwg/mapped_file.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <fmt/format.h>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// How the fields of an edge list line are separated.
+	enum class edge_list_format {
+		// Runs of spaces and tabs, with blank lines and lines starting with '#' skipped, as in most
+		// published graph dumps.
+		whitespace,
+		// Exactly one ',' between fields, each taken verbatim. Quoting isn't supported.
+		csv,
+		// Exactly one tab between fields, each taken verbatim.
+		tsv,
+	};
+
+	struct edge_list_options {
+		edge_list_format format = edge_list_format::whitespace;
+		// Whether the first line names the columns and is skipped.
+		bool header = false;
+		// Worker threads, or 0 for one per hardware thread.
+		std::size_t threads = 0;
+		graph_storage storage = graph_storage::heap;
+	};
+
+	namespace detail {
+		// Below this many bytes per worker, a load uses fewer workers.
+		inline constexpr auto edge_list_chunk_bytes = std::size_t{1} << 16;
+
+		// What one worker read from its share of the input: its edges, sorted and deduplicated,
+		// and the nodes named on lines of their own.
+		template<typename N, typename E>
+		struct edge_list_run {
+			std::vector<typename graph<N, E>::value_type> edges;
+			std::vector<N> nodes;
+			// Where the first malformed line starts, and what is wrong with it.
+			std::size_t error_offset = std::numeric_limits<std::size_t>::max();
+			char const* error = nullptr;
+			std::exception_ptr exception;
+		};
+
+		template<typename V>
+		auto edge_less(V const& a, V const& b) -> bool {
+			return std::tie(a.from, a.to, a.weight) < std::tie(b.from, b.to, b.weight);
+		}
+
+		template<typename V>
+		auto edge_equal(V const& a, V const& b) -> bool {
+			return std::tie(a.from, a.to, a.weight) == std::tie(b.from, b.to, b.weight);
+		}
+
+		// Splits a line into fields, returning how many it has. Only the first fields.size() are
+		// stored; a larger count means the line has too many.
+		template<std::size_t Count>
+		auto split_fields(std::string_view line,
+		                  edge_list_format format,
+		                  std::array<std::string_view, Count>& fields) -> std::size_t {
+			auto count = std::size_t{0};
+			auto store = [&fields, &count](std::string_view field) {
+				if (count < Count) {
+					fields[count] = field;
+				}
+				++count;
+			};
+			if (format == edge_list_format::whitespace) {
+				constexpr auto blanks = std::string_view(" \t");
+				for (auto first = line.find_first_not_of(blanks); first != std::string_view::npos;
+				     first = line.find_first_not_of(blanks, first)) {
+					auto const last = std::min(line.find_first_of(blanks, first), line.size());
+					store(line.substr(first, last - first));
+					first = last;
+				}
+				return count;
+			}
+			if (line.empty()) {
+				return 0;
+			}
+			auto const separator = format == edge_list_format::csv ? ',' : '\t';
+			for (auto first = std::size_t{0};;) {
+				auto const last = line.find(separator, first);
+				store(line.substr(first, last - first));
+				if (last == std::string_view::npos) {
+					return count;
+				}
+				first = last + 1;
+			}
+		}
+
+		// Adds what one line holds to the run, returning why it can't be read or nullptr.
+		template<typename N, typename E>
+		auto parse_edge_list_line(std::string_view line,
+		                          edge_list_format format,
+		                          edge_list_run<N, E>& run) -> char const* {
+			auto fields = std::array<std::string_view, 3>();
+			auto const count = split_fields(line, format, fields);
+			if (count == 0 or (format == edge_list_format::whitespace and fields[0].front() == '#')) {
+				return nullptr;
+			}
+			if (count == 1) {
+				return parse_value(fields[0], run.nodes.emplace_back()) ? nullptr
+				                                                        : "the node can't be parsed";
+			}
+			if (count != 3) {
+				return "expected 'src dst weight' or a lone node";
+			}
+			auto& edge = run.edges.emplace_back();
+			if (not parse_value(fields[0], edge.from)) {
+				return "the source node can't be parsed";
+			}
+			if (not parse_value(fields[1], edge.to)) {
+				return "the destination node can't be parsed";
+			}
+			if (not parse_value(fields[2], edge.weight)) {
+				return "the weight can't be parsed";
+			}
+			return nullptr;
+		}
+
+		// Parses the lines that start within [first, last) of text. A line that starts before
+		// `first` belongs to the worker before, even when it ends inside this share.
+		template<typename N, typename E>
+		auto parse_edge_list_lines(std::string_view text,
+		                           std::size_t first,
+		                           std::size_t last,
+		                           edge_list_options const& options,
+		                           edge_list_run<N, E>& run) -> void {
+			auto position = first;
+			if (first != 0) {
+				auto const newline = text.find('\n', first - 1);
+				position = newline == std::string_view::npos ? text.size() : newline + 1;
+			}
+			else if (options.header) {
+				auto const newline = text.find('\n');
+				position = newline == std::string_view::npos ? text.size() : newline + 1;
+			}
+			while (position < last) {
+				auto const newline = text.find('\n', position);
+				auto const end = newline == std::string_view::npos ? text.size() : newline;
+				auto line = text.substr(position, end - position);
+				if (not line.empty() and line.back() == '\r') {
+					line.remove_suffix(1);
+				}
+				if (auto const* error = parse_edge_list_line(line, options.format, run)) {
+					run.error_offset = position;
+					run.error = error;
+					return;
+				}
+				position = end + 1;
+			}
+		}
+
+		// Merges two sorted, deduplicated runs of edges into one.
+		template<typename V>
+		auto merge_edge_runs(std::vector<V>& into, std::vector<V>& from) -> void {
+			auto merged = std::vector<V>();
+			merged.reserve(into.size() + from.size());
+			std::merge(std::make_move_iterator(into.begin()),
+			           std::make_move_iterator(into.end()),
+			           std::make_move_iterator(from.begin()),
+			           std::make_move_iterator(from.end()),
+			           std::back_inserter(merged),
+			           edge_less<V>);
+			merged.erase(std::unique(merged.begin(), merged.end(), edge_equal<V>), merged.end());
+			into = std::move(merged);
+			from = std::vector<V>();
+		}
+
+		// Parses an edge list split into `chunks` shares at line boundaries, one worker each. Every
+		// worker parses and sorts its own edges; the sorted runs are then merged in pairs, each
+		// round in parallel, and bulk-loaded, so no worker ever waits on a shared graph.
+		template<typename N, typename E>
+		auto parse_edge_list(std::string_view text,
+		                     edge_list_options const& options,
+		                     std::size_t chunks) -> graph<N, E> {
+			using value_type = typename graph<N, E>::value_type;
+			chunks = std::max(chunks, std::size_t{1});
+			auto runs = std::vector<edge_list_run<N, E>>(chunks);
+			auto parse = [&](std::size_t first, std::size_t last, std::size_t chunk) {
+				auto& run = runs[chunk];
+				try {
+					parse_edge_list_lines(text, first, last, options, run);
+					if (run.error == nullptr) {
+						std::sort(run.edges.begin(), run.edges.end(), edge_less<value_type>);
+						auto const duplicates =
+						   std::unique(run.edges.begin(), run.edges.end(), edge_equal<value_type>);
+						run.edges.erase(duplicates, run.edges.end());
+					}
+				} catch (...) {
+					run.exception = std::current_exception();
+				}
+			};
+			for_each_chunk(text.size(), chunks, parse);
+
+			// Shares are in input order, so the first that failed holds the first bad line.
+			for (auto const& run : runs) {
+				if (run.exception) {
+					std::rethrow_exception(run.exception);
+				}
+				if (run.error != nullptr) {
+					auto const before = text.substr(0, run.error_offset);
+					auto const line = std::count(before.begin(), before.end(), '\n') + 1;
+					throw std::runtime_error(
+					   fmt::format("Cannot load a gdwg::graph<N, E> edge list from line {}: {}",
+					               line,
+					               run.error));
+				}
+			}
+
+			auto merge = [&runs](std::size_t first, std::size_t last, std::size_t) {
+				for (auto i = first; i != last; ++i) {
+					merge_edge_runs(runs[2 * i].edges, runs[2 * i + 1].edges);
+					auto& nodes = runs[2 * i].nodes;
+					auto& more = runs[2 * i + 1].nodes;
+					nodes.insert(nodes.end(),
+					             std::make_move_iterator(more.begin()),
+					             std::make_move_iterator(more.end()));
+				}
+			};
+			while (runs.size() > 1) {
+				auto const pairs = runs.size() / 2;
+				for_each_chunk(pairs, pairs, merge);
+				for (auto i = std::size_t{1}; i < runs.size(); ++i) {
+					if (i % 2 == 0) {
+						runs[i / 2] = std::move(runs[i]);
+					}
+				}
+				runs.resize((runs.size() + 1) / 2);
+			}
+
+			auto const& loaded = runs.front();
+			auto result =
+			   graph<N, E>(sorted_unique, loaded.edges.begin(), loaded.edges.end(), options.storage);
+			for (auto const& node : loaded.nodes) {
+				result.insert_node(node);
+			}
+			return result;
+		}
+	} // namespace detail
+
+	// Loads a graph from an edge list file: one `src dst weight` edge per line, in the given
+	// format, with a line holding a single field adding a node without edges. Nodes and weights
+	// are parsed as graph_reader parses them. The file is memory-mapped and split at line
+	// boundaries across worker threads, which parse and sort their share independently; the
+	// sorted shares are merged and loaded in bulk. Throws on a malformed line, naming the first.
+	template<typename N, typename E>
+	[[nodiscard]] auto load_edge_list(std::filesystem::path const& path,
+	                                  edge_list_options const& options = edge_list_options())
+	   -> graph<N, E> {
+		auto const file = detail::mapped_file(path, "gdwg::load_edge_list");
+		file.advise_sequential();
+		auto const threads = options.threads != 0 ? options.threads : detail::hardware_threads();
+		auto const chunks = std::clamp(file.size() / detail::edge_list_chunk_bytes,
+		                               std::size_t{1},
+		                               threads);
+		return detail::parse_edge_list<N, E>(std::string_view(file.data(), file.size()),
+		                                     options,
+		                                     chunks);
+	}
+} // namespace gdwg
+
+#endif // GDWG_EDGE_LIST_HPP
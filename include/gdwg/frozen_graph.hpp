@@ -0,0 +1,293 @@
+#ifndef GDWG_FROZEN_GRAPH_HPP
+#define GDWG_FROZEN_GRAPH_HPP
+
+#include "gdwg/graph.hpp"
+#include "gdwg/simd_search.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ostream>
+#include <range/v3/utility.hpp>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// An immutable snapshot of a gdwg::graph packed into compressed sparse row form.
+	//
+	// nodes_ holds every node in sorted order. The outgoing edges of nodes_[i] occupy the half-open
+	// range [offsets_[i], offsets_[i + 1]) of dsts_ and weights_, sorted by (destination, weight),
+	// so every read walks contiguous memory instead of chasing tree nodes. Those arrays are searched
+	// a vector at a time, as are nodes_ and the weights when N and E are arithmetic.
+	template<concepts::regular N, concepts::regular E>
+	requires concepts::totally_ordered<N> //
+	   and concepts::totally_ordered<E> //
+
+	   class frozen_graph {
+	public:
+		class iterator;
+
+		// ======================================
+		//              Constructors
+		// ======================================
+		frozen_graph() noexcept = default;
+
+		explicit frozen_graph(graph<N, E> const& g)
+		: nodes_(g.nodes()) {
+			offsets_.reserve(nodes_.size() + 1);
+			// Edges arrive in (src, dst, weight) order, which is the order the arrays keep.
+			auto src = std::size_t{0};
+			for (auto it = g.begin(); it != g.end(); ++it) {
+				auto const& [from, to, weight] = *it;
+				while (nodes_[src] != from) {
+					offsets_.push_back(dsts_.size());
+					++src;
+				}
+				dsts_.push_back(find_index(to));
+				weights_.push_back(weight);
+			}
+			while (offsets_.size() < nodes_.size() + 1) {
+				offsets_.push_back(dsts_.size());
+			}
+		}
+
+		// Rebuilds a mutable graph holding the same nodes and edges. The arrays are already in
+		// (from, to, weight) order, so the edges go through the sorted bulk load.
+		[[nodiscard]] auto thaw() const -> graph<N, E> {
+			auto values = std::vector<typename graph<N, E>::value_type>();
+			values.reserve(dsts_.size());
+			for (auto src = std::size_t{0}; src < nodes_.size(); ++src) {
+				for (auto i = offsets_[src]; i != offsets_[src + 1]; ++i) {
+					values.push_back({nodes_[src], nodes_[dsts_[i]], weights_[i]});
+				}
+			}
+			auto result = graph<N, E>(sorted_unique, values.begin(), values.end());
+			for (auto const& node : nodes_) {
+				result.insert_node(node);
+			}
+			return result;
+		}
+
+		// ======================================
+		//              Accessors
+		// ======================================
+		template<typename K = N>
+		requires node_key<K, N>
+		[[nodiscard]] auto is_node(K const& value) const -> bool {
+			return find_index(value) != npos;
+		}
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return nodes_.empty();
+		}
+
+		template<typename K1 = N, typename K2 = N>
+		requires node_key<K1, N> and node_key<K2, N>
+		[[nodiscard]] auto is_connected(K1 const& src, K2 const& dst) const -> bool {
+			auto src_index = find_index(src);
+			auto dst_index = find_index(dst);
+			if (src_index == npos || dst_index == npos) {
+				throw std::runtime_error("Cannot call gdwg::frozen_graph<N, E>::is_connected if src or "
+				                         "dst node don't exist in the graph");
+			}
+			auto [first, last] = edge_range(src_index, dst_index);
+			return first != last;
+		}
+
+		[[nodiscard]] auto nodes() const -> std::vector<N> const& {
+			return nodes_;
+		}
+
+		template<typename K1 = N, typename K2 = N>
+		requires node_key<K1, N> and node_key<K2, N>
+		[[nodiscard]] auto weights(K1 const& from, K2 const& to) const -> std::vector<E> {
+			auto src_index = find_index(from);
+			auto dst_index = find_index(to);
+			if (src_index == npos || dst_index == npos) {
+				throw std::runtime_error("Cannot call gdwg::frozen_graph<N, E>::weights if src or dst "
+				                         "node don't exist in the graph");
+			}
+			auto [first, last] = edge_range(src_index, dst_index);
+			return std::vector<E>(weights_.begin() + static_cast<std::ptrdiff_t>(first),
+			                      weights_.begin() + static_cast<std::ptrdiff_t>(last));
+		}
+
+		template<typename K1 = N, typename K2 = N>
+		requires node_key<K1, N> and node_key<K2, N>
+		[[nodiscard]] auto find(K1 const& src, K2 const& dst, E const& weight) const -> iterator {
+			auto src_index = find_index(src);
+			auto dst_index = find_index(dst);
+			if (src_index == npos || dst_index == npos) {
+				return end();
+			}
+			auto [first, last] = edge_range(src_index, dst_index);
+			auto result = bound(weights_, first, last, weight);
+			if (result == last || weights_[result] != weight) {
+				return end();
+			}
+			return iterator(*this, src_index, result);
+		}
+
+		template<typename K = N>
+		requires node_key<K, N>
+		[[nodiscard]] auto connections(K const& src) const -> std::vector<N> {
+			auto src_index = find_index(src);
+			if (src_index == npos) {
+				throw std::runtime_error("Cannot call gdwg::frozen_graph<N, E>::connections if src "
+				                         "doesn't exist in the graph");
+			}
+			auto result = std::vector<N>();
+			for (auto i = offsets_[src_index]; i != offsets_[src_index + 1]; ++i) {
+				if (i == offsets_[src_index] || dsts_[i] != dsts_[i - 1]) {
+					result.push_back(nodes_[dsts_[i]]);
+				}
+			}
+			return result;
+		}
+
+		// ======================================
+		//              Range Access
+		// ======================================
+		[[nodiscard]] auto begin() const -> iterator {
+			return iterator(*this, source_of(0, 0), 0);
+		}
+
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator(*this, nodes_.size(), dsts_.size());
+		}
+
+		// ======================================
+		//              Extractor
+		// ======================================
+		friend auto operator<<(std::ostream& os, frozen_graph const& g) -> std::ostream& {
+			for (auto src = std::size_t{0}; src < g.nodes_.size(); ++src) {
+				os << g.nodes_[src] << " (\n";
+				for (auto i = g.offsets_[src]; i != g.offsets_[src + 1]; ++i) {
+					os << "  " << g.nodes_[g.dsts_[i]] << " | " << g.weights_[i] << '\n';
+				}
+				os << ")\n";
+			}
+			return os;
+		}
+
+		// ======================================
+		//              Iterators
+		// ======================================
+		class iterator {
+		public:
+			using value_type = ranges::common_tuple<N, N, E>;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			// Iterator constructor
+			iterator() = default;
+
+			// Iterator source
+			auto operator*() const -> ranges::common_tuple<N const&, N const&, E const&> {
+				return ranges::common_tuple<N const&, N const&, E const&>{
+				   pointee_->nodes_[src_],
+				   pointee_->nodes_[pointee_->dsts_[edge_]],
+				   pointee_->weights_[edge_]};
+			}
+
+			// Iterator traversal
+			auto operator++() -> iterator& {
+				++edge_;
+				src_ = pointee_->source_of(src_, edge_);
+				return *this;
+			}
+			auto operator++(int) -> iterator {
+				auto temp = *this;
+				++*this;
+				return temp;
+			}
+			auto operator--() -> iterator& {
+				--edge_;
+				while (pointee_->offsets_[src_] > edge_) {
+					--src_;
+				}
+				return *this;
+			}
+			auto operator--(int) -> iterator {
+				auto temp = *this;
+				--*this;
+				return temp;
+			}
+
+			// Iterator comparison
+			auto operator==(iterator const& other) const -> bool {
+				return edge_ == other.edge_;
+			}
+
+		private:
+			frozen_graph const* pointee_ = nullptr;
+			std::size_t src_ = 0;
+			std::size_t edge_ = 0;
+			friend class frozen_graph;
+			explicit iterator(frozen_graph const& pointee, std::size_t src, std::size_t edge) noexcept
+			: pointee_(&pointee)
+			, src_(src)
+			, edge_(edge) {}
+		};
+
+	private:
+		static constexpr auto npos = static_cast<std::size_t>(-1);
+
+		std::vector<N> nodes_;
+		std::vector<std::size_t> offsets_ = {0};
+		std::vector<std::size_t> dsts_;
+		std::vector<E> weights_;
+
+		// std::lower_bound over [first, last) of one of the arrays, as an index. Vectorised when T
+		// is arithmetic and the key is a T too.
+		template<typename T, typename K>
+		static auto
+		bound(std::vector<T> const& values, std::size_t first, std::size_t last, K const& key)
+		   -> std::size_t {
+			if constexpr (detail::simd_searchable<T> and std::is_same_v<T, K>) {
+				auto const* data = values.data();
+				return static_cast<std::size_t>(
+				   detail::simd_lower_bound(data + first, data + last, key) - data);
+			}
+			else {
+				auto const begin = values.begin();
+				auto const result = std::lower_bound(begin + static_cast<std::ptrdiff_t>(first),
+				                                     begin + static_cast<std::ptrdiff_t>(last),
+				                                     key,
+				                                     std::less<>());
+				return static_cast<std::size_t>(result - begin);
+			}
+		}
+
+		template<typename K>
+		auto find_index(K const& node) const -> std::size_t {
+			auto result = bound(nodes_, 0, nodes_.size(), node);
+			if (result == nodes_.size() || nodes_[result] != node) {
+				return npos;
+			}
+			return result;
+		}
+
+		// Edge indices in [first, last) that run from src to dst.
+		auto edge_range(std::size_t src, std::size_t dst) const
+		   -> std::pair<std::size_t, std::size_t> {
+			auto const lower = bound(dsts_, offsets_[src], offsets_[src + 1], dst);
+			return {lower, bound(dsts_, lower, offsets_[src + 1], dst + 1)};
+		}
+
+		// The source owning `edge`, searching forward from `src` past nodes with no outgoing edges.
+		auto source_of(std::size_t src, std::size_t edge) const -> std::size_t {
+			while (src < nodes_.size() && offsets_[src + 1] <= edge) {
+				++src;
+			}
+			return src;
+		}
+	};
+
+	template<typename N, typename E>
+	frozen_graph(graph<N, E> const&) -> frozen_graph<N, E>;
+} // namespace gdwg
+
+#endif // GDWG_FROZEN_GRAPH_HPP
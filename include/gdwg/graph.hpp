@@ -1,12 +1,82 @@
 #ifndef GDWG_GRAPH_HPP
 #define GDWG_GRAPH_HPP
 
+#include "gdwg/graph_stats.hpp"
+#include "gdwg/parallel.hpp"
+#include "gdwg/query_cache.hpp"
+#include "gdwg/small_flat_set.hpp"
+#include "gdwg/soa_adjacency.hpp"
+#include "gdwg/text_buffer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
 #include <map>
+#include <memory>
+#include <memory_resource>
 #include <ostream>
+#include <range/v3/algorithm/equal.hpp>
 #include <range/v3/utility.hpp>
+#include <range/v3/view/subrange.hpp>
 #include <set>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace gdwg {
+	// Any type that can be ordered against N can be used to look a node up without first
+	// constructing an N from it, e.g. a std::string_view for a std::string node.
+	template<typename K, typename N>
+	concept node_key = concepts::totally_ordered_with<K, N>;
+
+	// Where a graph gets the memory for its nodes, edges and weights.
+	enum class graph_storage {
+		// std::pmr::get_default_resource(), which is plain new/delete unless overridden.
+		heap,
+		// A monotonic arena owned by the graph. Erasing never returns memory; clear() and the
+		// destructor release the whole arena at once, without visiting every element when N and E
+		// are trivially destructible or allocate from the graph themselves (e.g. std::pmr::string).
+		arena,
+		// Size-class pools owned by the graph, which recycle memory freed by erasures. Suited to
+		// mutation-heavy workloads.
+		pool,
+	};
+
+	// Tags a range of edges that is already sorted by (from, to, weight) and free of duplicates.
+	struct sorted_unique_t {
+		explicit sorted_unique_t() = default;
+	};
+	inline constexpr auto sorted_unique = sorted_unique_t();
+
+	// Asks for a graph that also indexes the incoming edges of every node. predecessors() and
+	// in_degree() then take O(in-degree), and erasing, replacing or merging a node only visits its
+	// own edges instead of every source, at the cost of one index entry per (src, dst) pair.
+	struct incoming_index_t {
+		explicit incoming_index_t() = default;
+	};
+	inline constexpr auto incoming_index = incoming_index_t();
+
+	// Asks for a graph that also indexes every edge by weight, which edges_in_weight_range() and
+	// top_k_edges() need. Every modifier keeps the index in step, at the cost of one entry per
+	// edge holding a copy of its weight.
+	struct weight_index_t {
+		explicit weight_index_t() = default;
+	};
+	inline constexpr auto weight_index = weight_index_t();
+
+	// Which end of the weight order top_k_edges() takes edges from.
+	enum class weight_order { lightest, heaviest };
+
+	namespace detail {
+		struct cache_access;
+	} // namespace detail
+
 	template<concepts::regular N, concepts::regular E>
 	requires concepts::totally_ordered<N> //
 	   and concepts::totally_ordered<E> //
@@ -14,6 +84,7 @@ namespace gdwg {
 	   class graph {
 	public:
 		class iterator;
+		class weight_iterator;
 
 		struct value_type {
 			N from;
@@ -21,254 +92,613 @@ namespace gdwg {
 			E weight;
 		};
 
-		struct pair_cmp {
-			auto operator()(std::pair<N*, N*> a, std::pair<N*, N*> b) -> bool {
-				return *a->first == *b->first ? *a->second < *b->second : *a->first < *b->first;
+		// One operation of a batch passed to apply(). Fields an operation doesn't use are ignored.
+		struct mutation {
+			enum class kind { insert_node, insert_edge, erase_node, erase_edge };
+
+			kind op;
+			N src;
+			N dst = N();
+			E weight = E();
+
+			static auto insert_node(N value) -> mutation {
+				return {kind::insert_node, std::move(value)};
+			}
+			static auto erase_node(N value) -> mutation {
+				return {kind::erase_node, std::move(value)};
+			}
+			static auto insert_edge(N src, N dst, E weight) -> mutation {
+				return {kind::insert_edge, std::move(src), std::move(dst), std::move(weight)};
+			}
+			static auto erase_edge(N src, N dst, E weight) -> mutation {
+				return {kind::erase_edge, std::move(src), std::move(dst), std::move(weight)};
+			}
+		};
+
+		struct node_ptr_cmp {
+			auto operator()(N const* a, N const* b) const -> bool {
+				// Nodes are unique by value, so pointer identity is enough to detect equal nodes.
+				if (a == b) {
+					return false;
+				}
+				detail::count_comparison();
+				return *a < *b;
+			}
+		};
+
+	private:
+		// Every container draws from the graph's memory resource. The weights of a (src, dst) pair
+		// sit in a flat sorted array inside its adjacency entry, so a pair with only a few weights
+		// needs no allocation of its own.
+		using node_set = std::pmr::set<N, detail::counting_less>;
+		using weight_set = detail::small_flat_set<E>;
+		// The outgoing adjacency of a single node: destination -> weights of the parallel edges.
+		// When N and E are both arithmetic it is a detail::soa_adjacency, which searches a large
+		// adjacency's destinations as a column of values.
+		using adjacency = typename detail::adjacency_layout<N, E, weight_set, node_ptr_cmp>::type;
+		// Source -> outgoing adjacency. Only nodes with at least one outgoing edge appear here, and
+		// an adjacency never holds an empty weight_set.
+		using edge_map = std::pmr::map<N const*, adjacency, node_ptr_cmp>;
+		// The incoming edges of a single node: source -> the weights of its edges, owned by edges_.
+		using in_adjacency = std::pmr::map<N const*, weight_set const*, node_ptr_cmp>;
+		// Destination -> incoming edges, holding an entry exactly where edges_ has one.
+		using incoming_map = std::pmr::map<N const*, in_adjacency, node_ptr_cmp>;
+
+		// One edge of the weight index. The weight is a copy, as a weight_set moves its elements
+		// around as it grows.
+		struct weight_entry {
+			E weight;
+			N const* src;
+			N const* dst;
+		};
+		// Orders the weight index by (weight, src, dst), so edges of equal weight keep the order of
+		// begin() to end(). A bare weight finds the run of edges that carry it.
+		struct weight_entry_cmp {
+			using is_transparent = void;
+
+			auto operator()(weight_entry const& a, weight_entry const& b) const -> bool {
+				if (a.weight < b.weight) {
+					return true;
+				}
+				if (b.weight < a.weight) {
+					return false;
+				}
+				auto const less = node_ptr_cmp();
+				return a.src != b.src ? less(a.src, b.src) : less(a.dst, b.dst);
+			}
+			auto operator()(weight_entry const& a, E const& b) const -> bool {
+				return a.weight < b;
 			}
-			auto operator()(std::pair<N*, N*> a, std::pair<N*, N*> b) const -> bool {
-				return *a.first == *b.first ? *a.second < *b.second : *a.first < *b.first;
+			auto operator()(E const& a, weight_entry const& b) const -> bool {
+				return a < b.weight;
 			}
 		};
+		// Every edge, holding an entry exactly where a weight_set of edges_ has a weight.
+		using weight_index_set = std::pmr::set<weight_entry, weight_entry_cmp>;
 
+		// Whether an arena can be dropped without running the element destructors: nothing they
+		// would free lives outside the arena.
+		template<typename T>
+		static constexpr bool arena_releasable =
+		   std::is_trivially_destructible_v<T>
+		   or std::uses_allocator_v<T, std::pmr::polymorphic_allocator<std::byte>>;
+
+	public:
 		// Your member functions go here
 
 		// ======================================
 		//              Constructors
 		// ======================================
-		graph() noexcept {
-			this->nodes_ = std::set<std::unique_ptr<N>>();
-			this->edges_ = std::map<std::pair<N*, N*>, std::set<std::unique_ptr<E>>, pair_cmp>();
+		graph() noexcept
+		: graph(std::pmr::get_default_resource()) {}
+
+		// Allocates from `resource`, which must outlive the graph.
+		explicit graph(std::pmr::memory_resource* resource) noexcept
+		: nodes_(instrument_resource(resource))
+		, edges_(allocation_resource()) {}
+
+		explicit graph(graph_storage storage)
+		: owned_resource_(make_resource(storage))
+		, storage_(storage)
+		, nodes_(instrument_resource(resource_for(owned_resource_.get())))
+		, edges_(allocation_resource()) {}
+
+		explicit graph(incoming_index_t, graph_storage storage = graph_storage::heap)
+		: graph(storage) {
+			incoming_ = std::make_unique<incoming_map>(allocation_resource());
+		}
+
+		explicit graph(weight_index_t, graph_storage storage = graph_storage::heap)
+		: graph(storage) {
+			weight_index_ = std::make_unique<weight_index_set>(allocation_resource());
 		}
-		graph(std::initializer_list<N> il) {
-			this->nodes_ = std::set<std::unique_ptr<N>>();
-			this->edges_ = std::map<std::pair<N*, N*>, std::set<std::unique_ptr<E>>, pair_cmp>();
+
+		graph(incoming_index_t, weight_index_t, graph_storage storage = graph_storage::heap)
+		: graph(incoming_index, storage) {
+			weight_index_ = std::make_unique<weight_index_set>(allocation_resource());
+		}
+
+		graph(std::initializer_list<N> il)
+		: graph() {
 			for (auto temp = il.begin(); temp != il.end(); temp++) {
 				this->insert_node(*temp);
 			}
 		}
 		// Needs to be finished
 		template<ranges::forward_iterator I, ranges::sentinel_for<I> S>
-		requires ranges::indirectly_copyable<I, N*> graph(I first, S last) {
+		requires ranges::indirectly_copyable<I, N*> graph(I first, S last)
+		: graph() {
 			for (auto temp = first; temp != last; temp++) {
 				this->insert_node(*temp);
 			}
 		}
-		// Needs to be finished
+		// Bulk load: the edges are sorted and deduplicated up front, after which every container is
+		// filled in order, so loading E edges costs O(E log E) rather than E separate insertions.
 		template<ranges::forward_iterator I, ranges::sentinel_for<I> S>
-		requires ranges::indirectly_copyable<I, value_type*> graph(I first, S last) {
-			for (auto temp = first; temp != last; temp++) {
-				this->insert_node(temp->to);
-				this->insert_node(temp->from);
-				this->insert_edge(temp->from, temp->to, temp->weight);
+		requires ranges::indirectly_copyable<I, value_type*>
+		graph(I first, S last, graph_storage storage = graph_storage::heap)
+		: graph(storage) {
+			auto values = std::vector<value_type>();
+			for (; first != last; ++first) {
+				values.push_back(*first);
 			}
+			auto key = [](value_type const& v) { return std::tie(v.from, v.to, v.weight); };
+			std::sort(values.begin(), values.end(), [&key](value_type const& a, value_type const& b) {
+				return key(a) < key(b);
+			});
+			auto duplicates = std::unique(values.begin(),
+			                              values.end(),
+			                              [&key](value_type const& a, value_type const& b) {
+				                              return key(a) == key(b);
+			                              });
+			values.erase(duplicates, values.end());
+			bulk_load(values.begin(), values.end(), values.size());
+		}
+
+		// Bulk load of a range the caller promises is already sorted by (from, to, weight) without
+		// duplicates, which skips the sort. A range that breaks the promise still loads the same
+		// graph as the unsorted constructor would, only more slowly.
+		template<ranges::forward_iterator I, ranges::sentinel_for<I> S>
+		requires ranges::indirectly_copyable<I, value_type*>
+		graph(sorted_unique_t, I first, S last, graph_storage storage = graph_storage::heap)
+		: graph(storage) {
+			bulk_load(first, last, static_cast<std::size_t>(ranges::distance(first, last)));
 		}
 
-		graph(graph&& other) noexcept {
-			this->nodes_ = std::move(other.nodes_);
-			this->edges_ = std::move(other.edges_);
+		// The moved-to graph takes over the other graph's memory resource; the moved-from graph is
+		// left empty on the default resource.
+		graph(graph&& other) noexcept
+		: owned_resource_(std::move(other.owned_resource_))
+		, storage_(other.storage_)
+		, instrumentation_(std::move(other.instrumentation_))
+		, nodes_(std::move(other.nodes_))
+		, edges_(std::move(other.edges_))
+		, incoming_(std::move(other.incoming_))
+		, weight_index_(std::move(other.weight_index_))
+		, query_cache_(std::move(other.query_cache_)) {
+			auto const probe = instrument(graph_operation::move_construct);
+			other.reset_storage();
 		}
 
 		auto operator=(graph&& other) noexcept -> graph& {
-			ranges::swap(this->nodes_, other.nodes_);
-			ranges::swap(this->edges_, other.edges_);
-			other.clear();
+			if (this == &other) {
+				return *this;
+			}
+			// Timed against the counters this graph is about to take over.
+			auto const probe = other.instrument(graph_operation::move_assign);
+			// Containers can't be swapped across different memory resources, so ours are torn down
+			// and rebuilt around the other graph's.
+			destroy_storage();
+			incoming_ = std::move(other.incoming_);
+			weight_index_ = std::move(other.weight_index_);
+			query_cache_ = std::move(other.query_cache_);
+			++version_;
+			owned_resource_ = std::move(other.owned_resource_);
+			storage_ = other.storage_;
+			instrumentation_ = std::move(other.instrumentation_);
+			std::construct_at(&nodes_, std::move(other.nodes_));
+			std::construct_at(&edges_, std::move(other.edges_));
+			other.reset_storage();
 			return *this;
 		}
 
-		graph(graph const& other) {
-			this->nodes_ = std::set<std::unique_ptr<N>>();
-			this->edges_ = std::map<std::pair<N*, N*>, std::set<std::unique_ptr<E>>, pair_cmp>();
-			for (auto temp : other.nodes()) {
-				this->insert_node(temp);
+		// A copy of an arena or pool graph gets its own arena or pool. Like the std::pmr containers,
+		// a copy of a graph on a caller-supplied resource uses the default resource. A copy of a
+		// graph with an incoming or weight index has one too, and likewise a query cache, which
+		// starts out empty.
+		graph(graph const& other)
+		: graph(other.storage_) {
+			if (other.incoming_) {
+				incoming_ = std::make_unique<incoming_map>(allocation_resource());
 			}
-			for (auto [key, value] : other.all_edges()) {
-				for (auto temp : value) {
-					this->insert_edge(key.first, key.second, temp);
-				}
+			if (other.weight_index_) {
+				weight_index_ = std::make_unique<weight_index_set>(allocation_resource());
 			}
+			if (other.query_cache_) {
+				enable_query_cache();
+			}
+			auto const probe = instrument(graph_operation::copy_construct);
+			clone_from(other);
 		}
 
+		// This graph ends up with the counters of the copy it moves in, which have counted that
+		// copy's construction as well as this assignment.
 		auto operator=(graph const& other) -> graph& {
-			if (this == other) {
+			if (this == &other) {
 				return *this;
 			}
 			auto temp = other;
-			std::swap(this->nodes_, temp.nodes_);
-			std::swap(this->edges_, temp.edges_);
+			auto const probe = temp.instrument(graph_operation::copy_assign);
+			*this = std::move(temp);
 
 			return *this;
 		}
 
+		~graph() {
+			destroy_storage();
+		}
+
 		// ======================================
 		//              Modifiers
 		// ======================================
 		auto insert_node(N const& value) -> bool {
-			if (is_node(value)) {
-				return false;
+			auto const probe = instrument(graph_operation::insert_node);
+			auto const inserted = this->nodes_.insert(value).second;
+			if (inserted) {
+				modified();
 			}
-			auto temp = value;
-			auto new_node = std::make_unique<N>(temp);
-			this->nodes_.insert(std::move(new_node));
-			return true;
+			return inserted;
 		}
 
-		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool {
-			if (!is_node(src) || !is_node(dst)) {
+		template<typename K1 = N, typename K2 = N>
+		requires node_key<K1, N> and node_key<K2, N>
+		auto insert_edge(K1 const& src, K2 const& dst, E const& weight) -> bool {
+			auto const probe = instrument(graph_operation::insert_edge);
+			auto my_src = this->find_node_ptr(src);
+			auto my_dst = this->find_node_ptr(dst);
+			if (my_src == nullptr || my_dst == nullptr) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::insert_edge when either src "
 				                         "or dst node does not exist");
 			}
-			auto my_src = this->find_node_ptr(src);
-			auto my_dst = this->find_node_ptr(dst);
 
-			if (edge_exist(my_src, my_dst, weight)) {
-				return false;
+			auto [middle, added] = edges_[my_src].try_emplace(my_dst);
+			auto const inserted = middle->second.insert(weight).second;
+			if (added) {
+				link(my_src, my_dst, middle->second);
 			}
-
-			auto new_edge = std::make_unique<E>(weight);
-
-			edges_[std::make_pair(my_src, my_dst)].insert(std::move(new_edge));
-
-			return true;
+			if (inserted) {
+				index_weight(my_src, my_dst, weight);
+				added_weight(weight);
+				modified({my_src});
+			}
+			return inserted;
 		}
 
-		auto replace_node(N const& old_data, N const& new_data) -> bool {
-			if (!is_node(old_data)) {
+		template<typename K = N>
+		requires node_key<K, N>
+		auto replace_node(K const& old_data, N const& new_data) -> bool {
+			auto const probe = instrument(graph_operation::replace_node);
+			auto old_it = nodes_.find(old_data);
+			if (old_it == nodes_.end()) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::replace_node on a node that "
 				                         "doesn't exist");
 			}
 			if (is_node(new_data)) {
 				return false;
 			}
-			auto smart_ptr = find_node_ptr(old_data);
-			*smart_ptr = new_data;
+			// The node keeps its address across extract/insert, but edges_ and every adjacency are
+			// ordered by value, so each entry keyed by it has to be pulled out around the rename.
+			auto old_ptr = &*old_it;
+			modified({old_ptr});
+			auto weight_entries = extract_weight_entries(old_ptr);
+			auto outgoing = edges_.extract(old_ptr);
+			auto incoming = std::vector<std::pair<adjacency*, typename adjacency::node_type>>();
+			auto extract_incoming = [old_ptr, &incoming](adjacency& adj) {
+				if (auto handle = adj.extract(old_ptr); !handle.empty()) {
+					incoming.emplace_back(&adj, std::move(handle));
+				}
+			};
+			// The index holds the same keys, and also names the sources to look in.
+			auto index_outer = typename incoming_map::node_type();
+			auto index_inner =
+			   std::vector<std::pair<in_adjacency*, typename in_adjacency::node_type>>();
+			auto extract_index = [old_ptr, &index_inner](in_adjacency& in) {
+				if (auto handle = in.extract(old_ptr); !handle.empty()) {
+					index_inner.emplace_back(&in, std::move(handle));
+				}
+			};
+			if (incoming_) {
+				index_outer = incoming_->extract(old_ptr);
+				if (!index_outer.empty()) {
+					for (auto& [src, weights] : index_outer.mapped()) {
+						if (src != old_ptr) {
+							extract_incoming(edges_.find(src)->second);
+						}
+					}
+					extract_index(index_outer.mapped());
+				}
+				if (!outgoing.empty()) {
+					for (auto& [dst, weights] : outgoing.mapped()) {
+						if (dst != old_ptr) {
+							extract_index(incoming_->find(dst)->second);
+						}
+					}
+				}
+			}
+			else {
+				detail::count_adjacency_scans(edges_.size());
+				for (auto& [src, adj] : edges_) {
+					extract_incoming(adj);
+				}
+			}
+			if (!outgoing.empty()) {
+				extract_incoming(outgoing.mapped());
+			}
+
+			auto handle = nodes_.extract(old_it);
+			handle.value() = new_data;
+			nodes_.insert(std::move(handle));
 
+			if (!outgoing.empty()) {
+				edges_.insert(std::move(outgoing));
+			}
+			for (auto& [adj, temp] : incoming) {
+				adj->insert(std::move(temp));
+			}
+			if (!index_outer.empty()) {
+				incoming_->insert(std::move(index_outer));
+			}
+			for (auto& [in, temp] : index_inner) {
+				in->insert(std::move(temp));
+			}
+			for (auto& entry : weight_entries) {
+				weight_index_->insert(std::move(entry));
+			}
 			return true;
 		}
 
-		auto merge_replace_node(N const& old_data, N const& new_data) -> void {
-			if (!is_node(old_data) || !is_node(new_data)) {
+		template<typename K1 = N, typename K2 = N>
+		requires node_key<K1, N> and node_key<K2, N>
+		auto merge_replace_node(K1 const& old_data, K2 const& new_data) -> void {
+			auto const probe = instrument(graph_operation::merge_replace_node);
+			auto old_data_ptr = find_node_ptr(old_data);
+			auto new_data_ptr = find_node_ptr(new_data);
+			if (old_data_ptr == nullptr || new_data_ptr == nullptr) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::merge_replace_node on old or "
 				                         "new data if they don't exist in the graph");
 			}
-			auto old_data_ptr = find_node_ptr(old_data);
-			auto new_data_ptr = find_node_ptr(new_data);
-			auto need_replace = std::vector<std::pair<N*, N*>>();
-			for (auto temp = edges_.begin(); temp != edges_.end(); temp++) {
-				auto key = temp->first;
-				if (*key.first == new_data || *key.second == new_data) {
-					need_replace.push_back(key);
+			if (old_data_ptr == new_data_ptr) {
+				return;
+			}
+			modified({old_data_ptr, new_data_ptr});
+			// Outgoing edges of old_data move under new_data; a self-loop becomes new_data -> new_data.
+			if (auto outgoing = edges_.extract(old_data_ptr); !outgoing.empty()) {
+				auto& adj = edges_[new_data_ptr];
+				for (auto& [dst, weights] : outgoing.mapped()) {
+					unlink(old_data_ptr, dst);
+					auto const target = dst == old_data_ptr ? new_data_ptr : dst;
+					move_weight_entries(old_data_ptr, dst, weights, new_data_ptr, target);
+					auto& into = adj[target];
+					merge_weights(into, weights);
+					link(new_data_ptr, target, into);
 				}
 			}
-
-			for (auto temp : need_replace) {
-				auto modified_key = edges_.extract(temp);
-				if (modified_key.key().first == new_data_ptr) {
-					modified_key.key().first = old_data_ptr;
+			// Incoming edges of old_data are redirected to new_data.
+			auto redirect = [this, old_data_ptr, new_data_ptr](N const* src, adjacency& adj) {
+				if (auto handle = adj.extract(old_data_ptr); !handle.empty()) {
+					move_weight_entries(src, old_data_ptr, handle.mapped(), src, new_data_ptr);
+					auto& into = adj[new_data_ptr];
+					merge_weights(into, handle.mapped());
+					link(src, new_data_ptr, into);
 				}
-				else {
-					modified_key.key().second = old_data_ptr;
+			};
+			if (incoming_) {
+				if (auto in = incoming_->extract(old_data_ptr); !in.empty()) {
+					for (auto& [src, weights] : in.mapped()) {
+						redirect(src, edges_.find(src)->second);
+					}
+				}
+			}
+			else {
+				detail::count_adjacency_scans(edges_.size());
+				for (auto& [src, adj] : edges_) {
+					redirect(src, adj);
 				}
-				edges_.insert(std::move(modified_key));
 			}
 
-			erase_node(new_data);
-
-			*old_data_ptr = new_data;
+			nodes_.erase(nodes_.find(*old_data_ptr));
 		}
 
-		auto erase_node(N const& value) -> bool {
-			if (!is_node(value)) {
-				return false;
+		// Merges the first node of each pair into the second, with the same effect as calling
+		// merge_replace_node on the pairs in order. If one of them would throw, the merges before it
+		// are made and then its exception is thrown.
+		//
+		// With an incoming index every merge only visits the edges of the two nodes. Without one,
+		// the merges are resolved first, following chains such as a -> b, b -> c, and every edge
+		// that has to move is then found in a single sweep rather than one per merge.
+		auto merge_nodes(std::span<std::pair<N, N> const> merges) -> void {
+			auto const probe = instrument(graph_operation::merge_nodes);
+			if (incoming_) {
+				for (auto const& [old_data, new_data] : merges) {
+					merge_replace_node(old_data, new_data);
+				}
+				return;
 			}
 
-			auto it = edges_.begin();
-
-			while (it != edges_.end()) {
-				auto key = it->first;
-				if (*key.first == value || *key.second == value) {
-					it = edges_.erase(it);
+			// Merged-away node -> the node it was merged into, which may itself be merged later.
+			auto merged_into = std::unordered_map<N const*, N const*>();
+			auto resolve = [&merged_into](N const* node) {
+				auto root = node;
+				for (auto it = merged_into.find(root); it != merged_into.end();
+				     it = merged_into.find(root)) {
+					root = it->second;
 				}
-				else {
-					it++;
+				// Point the whole chain straight at its end, so it is walked only once.
+				for (auto it = merged_into.find(node); it != merged_into.end() && it->second != root;
+				     it = merged_into.find(node)) {
+					node = std::exchange(it->second, root);
+				}
+				return root;
+			};
+			auto failed = false;
+			for (auto const& [old_data, new_data] : merges) {
+				auto old_data_ptr = find_node_ptr(old_data);
+				auto new_data_ptr = find_node_ptr(new_data);
+				if (old_data_ptr == nullptr || new_data_ptr == nullptr
+				    || merged_into.contains(old_data_ptr) || merged_into.contains(new_data_ptr)) {
+					failed = true;
+					break;
+				}
+				if (old_data_ptr != new_data_ptr) {
+					merged_into.emplace(old_data_ptr, new_data_ptr);
 				}
 			}
 
-			auto it2 = nodes_.begin();
+			for (auto const& [node, into] : merged_into) {
+				modified({node, into});
+			}
 
-			while (it2 != nodes_.end()) {
-				if (**it2 == value) {
-					it2 = nodes_.erase(it2);
+			// Pull out every edge touching a merged-away node, then put each back under the nodes it
+			// ends up between, merging its weights with any edge already there.
+			auto moved_sources = std::vector<typename edge_map::node_type>();
+			auto moved_destinations =
+			   std::vector<std::pair<N const*, typename adjacency::node_type>>();
+			detail::count_adjacency_scans(edges_.size());
+			for (auto outer = edges_.begin(); outer != edges_.end();) {
+				if (merged_into.contains(outer->first)) {
+					moved_sources.push_back(edges_.extract(outer++));
+					continue;
 				}
-				else {
-					it2++;
+				auto& adj = outer->second;
+				for (auto middle = adj.begin(); middle != adj.end();) {
+					if (merged_into.contains(middle->first)) {
+						moved_destinations.emplace_back(outer->first, adj.extract(middle++));
+					}
+					else {
+						++middle;
+					}
+				}
+				++outer;
+			}
+			for (auto& handle : moved_sources) {
+				auto const* src = resolve(handle.key());
+				auto& adj = edges_[src];
+				for (auto& [dst, weights] : handle.mapped()) {
+					auto const* target = resolve(dst);
+					move_weight_entries(handle.key(), dst, weights, src, target);
+					merge_weights(adj[target], weights);
 				}
 			}
+			for (auto& [src, handle] : moved_destinations) {
+				auto const* target = resolve(handle.key());
+				move_weight_entries(src, handle.key(), handle.mapped(), src, target);
+				merge_weights(edges_[src][target], handle.mapped());
+			}
+			for (auto& [src, handle] : moved_destinations) {
+				if (auto outer = edges_.find(src); outer != edges_.end() && outer->second.empty()) {
+					edges_.erase(outer);
+				}
+			}
+
+			for (auto const& [node, into] : merged_into) {
+				nodes_.erase(nodes_.find(*node));
+			}
+			if (failed) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::merge_replace_node on old or "
+				                         "new data if they don't exist in the graph");
+			}
+		}
+
+		template<typename K = N>
+		requires node_key<K, N>
+		auto erase_node(K const& value) -> bool {
+			auto const probe = instrument(graph_operation::erase_node);
+			auto node_ptr = find_node_ptr(value);
+			if (node_ptr == nullptr) {
+				return false;
+			}
+
+			modified({node_ptr});
+			detach(node_ptr);
+			nodes_.erase(nodes_.find(*node_ptr));
 
 			return true;
 		}
 
-		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool {
-			if (!is_node(src) || !is_node(dst)) {
+		template<typename K1 = N, typename K2 = N>
+		requires node_key<K1, N> and node_key<K2, N>
+		auto erase_edge(K1 const& src, K2 const& dst, E const& weight) -> bool {
+			auto const probe = instrument(graph_operation::erase_edge);
+			auto src_ptr = find_node_ptr(src);
+			auto dst_ptr = find_node_ptr(dst);
+			if (src_ptr == nullptr || dst_ptr == nullptr) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::erase_edge on src or dst if "
 				                         "they don't exist in the graph");
 			}
 
-			if (!is_connected(src, dst)) {
+			auto outer = edges_.find(src_ptr);
+			if (outer == edges_.end()) {
+				return false;
+			}
+			auto middle = outer->second.find(dst_ptr);
+			if (middle == outer->second.end()) {
 				return false;
 			}
-			auto src_ptr = find_node_ptr(src);
-			auto dst_ptr = find_node_ptr(dst);
-
-			auto it = edges_.at(std::make_pair(src_ptr, dst_ptr)).begin();
 
-			while (it != edges_.at(std::make_pair(src_ptr, dst_ptr)).end()) {
-				if (**it == weight) {
-					edges_.at(std::make_pair(src_ptr, dst_ptr)).erase(it);
-					edges_.at(std::make_pair(src_ptr, dst_ptr)).end();
-					if (edges_.at(std::make_pair(src_ptr, dst_ptr)).empty()) {
-						edges_.erase(std::make_pair(src_ptr, dst_ptr));
-					}
-					return true;
+			if (middle->second.erase(weight) == 0) {
+				return false;
+			}
+			modified({src_ptr});
+			unindex_weight(src_ptr, dst_ptr, weight);
+			if (middle->second.empty()) {
+				unlink(src_ptr, dst_ptr);
+				outer->second.erase(middle);
+				if (outer->second.empty()) {
+					edges_.erase(outer);
 				}
-
-				it++;
 			}
-			return false;
+			return true;
 		}
 
+		// Amortised O(1): the weight is erased in place, and so is its (src, dst) entry and then its
+		// source entry once they become empty.
 		auto erase_edge(iterator i) -> iterator {
-			/*
-			This was my initial attempt on this function, but it doesnt let me use
-			i.outer_->second.erase(i.inner) with a warning saying that the set.erase(iterator) function
-			is not marked const. If you have enough time is it alright if you give me a hint on why
-			this is not working.
-
-			auto new_set_it = i.outer_->second.erase(i.inner_); //I got stopped in this line
-			auto new_inner = i.inner_;
-			auto new_outer = i.outer_;
-			if (i.outer_->second.end() == i_inner){
-			   new_outer = new_outer++;
-			   new_inner = new_outer->second.begin();
-			}
-			return iterator(edges_, new_outer, new_inner); */
-
-			// Very Naive Method, does not satisfy time complexity
+			auto const probe = instrument(graph_operation::erase_edge);
 			if (i == this->end()) {
 				return this->end();
 			}
-			auto next = i;
-			next++;
-			bool next_is_end = next == this->end();
-
-			auto next_value = next == this->end() ? *i : *next;
-
-			erase_edge(std::get<0>(*i), std::get<1>(*i), std::get<2>(*i));
-			return next_is_end
-			          ? this->end()
-			          : find(std::get<0>(next_value), std::get<1>(next_value), std::get<2>(next_value));
+			// The iterator only holds const_iterators. Erasing an empty range turns one into the
+			// matching mutable iterator in constant time.
+			auto outer = edges_.erase(i.outer_, i.outer_);
+			auto& adj = outer->second;
+			auto middle = adj.erase(i.middle_, i.middle_);
+			auto& weights = middle->second;
+
+			modified({outer->first});
+			unindex_weight(outer->first, middle->first, *i.inner_);
+			if (auto inner = weights.erase(i.inner_); inner != weights.end()) {
+				return iterator(edges_, outer, middle, inner);
+			}
+			if (weights.empty()) {
+				unlink(outer->first, middle->first);
+				middle = adj.erase(middle);
+			}
+			else {
+				++middle;
+			}
+			if (middle != adj.end()) {
+				return iterator(edges_, outer, middle, middle->second.begin());
+			}
+			outer = adj.empty() ? edges_.erase(outer) : ranges::next(outer);
+			if (outer == edges_.end()) {
+				return this->end();
+			}
+			middle = outer->second.begin();
+			return iterator(edges_, outer, middle, middle->second.begin());
 		}
 
 		auto erase_edge(iterator i, iterator s) -> iterator {
+			auto const probe = instrument(graph_operation::erase_edge);
 			auto ret_it = i;
 
 			while (ret_it != s) {
@@ -277,183 +707,720 @@ namespace gdwg {
 			return ret_it;
 		}
 
+		// Applies a batch with the same effect as making each call in order, and returns what each
+		// call would have returned. If one of them would throw, the operations before it are
+		// applied and then its exception is thrown.
+		//
+		// Every node the batch names is looked up once. The edge operations are then sorted by
+		// (src, dst, weight) so each edge's net effect is applied in one ordered pass, and all node
+		// erasures share a single sweep over the edges.
+		auto apply(std::span<mutation const> batch) -> std::vector<bool> {
+			auto const probe = instrument(graph_operation::apply);
+			using kind = typename mutation::kind;
+			struct node_state {
+				N const* before = nullptr;
+				N const* after = nullptr;
+				bool alive = false;
+				// Indices of the operations that erased the node.
+				std::vector<std::size_t> erasures;
+			};
+			struct edge_operation {
+				std::size_t index;
+				node_state* src;
+				node_state* dst;
+				mutation const* op;
+			};
+
+			// Keyed by the first mention of each node in the batch.
+			auto states = std::map<N const*, node_state, node_ptr_cmp>();
+			auto resolve = [this, &states](N const& key) -> node_state& {
+				auto [it, inserted] = states.try_emplace(&key);
+				if (inserted) {
+					it->second.before = find_node_ptr(key);
+					it->second.alive = it->second.before != nullptr;
+				}
+				return it->second;
+			};
+
+			// Simulate the node operations in order; they decide which edge operations would throw.
+			auto results = std::vector<bool>();
+			results.reserve(batch.size());
+			auto edge_operations = std::vector<edge_operation>();
+			auto failure = static_cast<char const*>(nullptr);
+			for (auto const& op : batch) {
+				auto const index = results.size();
+				if (op.op == kind::insert_node) {
+					auto& node = resolve(op.src);
+					results.push_back(!node.alive);
+					node.alive = true;
+				}
+				else if (op.op == kind::erase_node) {
+					auto& node = resolve(op.src);
+					results.push_back(node.alive);
+					if (node.alive) {
+						node.alive = false;
+						node.erasures.push_back(index);
+					}
+				}
+				else {
+					auto& src = resolve(op.src);
+					auto& dst = resolve(op.dst);
+					if (!src.alive || !dst.alive) {
+						failure = op.op == kind::insert_edge
+						             ? "Cannot call gdwg::graph<N, E>::insert_edge when either src or "
+						               "dst node does not exist"
+						             : "Cannot call gdwg::graph<N, E>::erase_edge on src or dst if "
+						               "they don't exist in the graph";
+						break;
+					}
+					edge_operations.push_back({index, &src, &dst, &op});
+					results.push_back(false);
+				}
+			}
+			auto const end_index = results.size();
+
+			// Whether `node` was erased by an operation in [first, last).
+			auto erased_between = [](node_state const& node, std::size_t first, std::size_t last) {
+				auto it = std::lower_bound(node.erasures.begin(), node.erasures.end(), first);
+				return it != node.erasures.end() && *it < last;
+			};
+
+			// Replay the operations on each edge in order, from whether it existed before the batch.
+			// Erasing either endpoint drops the edge.
+			std::stable_sort(edge_operations.begin(),
+			                 edge_operations.end(),
+			                 [](edge_operation const& a, edge_operation const& b) {
+				                 return std::tie(a.op->src, a.op->dst, a.op->weight)
+				                        < std::tie(b.op->src, b.op->dst, b.op->weight);
+			                 });
+			auto edges_after = std::vector<std::pair<edge_operation const*, bool>>();
+			for (auto first = edge_operations.begin(); first != edge_operations.end();) {
+				auto const& [index, src, dst, op] = *first;
+				auto const* weights = src->before != nullptr && dst->before != nullptr
+				                         ? find_weights(src->before, dst->before)
+				                         : nullptr;
+				auto exists = weights != nullptr && weights->contains(op->weight);
+				auto last_index = std::size_t{0};
+				auto last = first;
+				for (; last != edge_operations.end() && last->src == src && last->dst == dst
+				       && !(op->weight < last->op->weight);
+				     ++last) {
+					if (erased_between(*src, last_index, last->index)
+					    || erased_between(*dst, last_index, last->index)) {
+						exists = false;
+					}
+					auto const insert = last->op->op == kind::insert_edge;
+					results[last->index] = insert != exists;
+					exists = insert;
+					last_index = last->index;
+				}
+				if (erased_between(*src, last_index, end_index)
+				    || erased_between(*dst, last_index, end_index)) {
+					exists = false;
+				}
+				edges_after.emplace_back(&*first, exists);
+				first = last;
+			}
+
+			// Nodes: one sweep drops every edge touching an erased node, then the survivors and
+			// newcomers are settled.
+			auto erased = std::vector<N const*>();
+			for (auto& [key, node] : states) {
+				if (node.before != nullptr && !node.erasures.empty()) {
+					erased.push_back(node.before);
+				}
+			}
+			if (!erased.empty()) {
+				modified(erased);
+				std::sort(erased.begin(), erased.end());
+				if (incoming_) {
+					// The index names every edge to drop, so there is nothing to sweep.
+					for (auto const* node : erased) {
+						detach(node);
+					}
+				}
+				else {
+					for (auto const* node : erased) {
+						if (auto outer = edges_.find(node); outer != edges_.end()) {
+							unindex_adjacency(node, outer->second);
+							edges_.erase(outer);
+						}
+					}
+					detail::count_adjacency_scans(edges_.size());
+					for (auto it = edges_.begin(); it != edges_.end();) {
+						auto& adj = it->second;
+						if (erased.size() < adj.size()) {
+							for (auto const* node : erased) {
+								if (auto middle = adj.find(node); middle != adj.end()) {
+									unindex_weights(it->first, node, middle->second);
+									adj.erase(middle);
+								}
+							}
+						}
+						else {
+							using std::erase_if;
+							erase_if(adj, [this, src = it->first, &erased](auto const& entry) {
+								auto const gone =
+								   std::binary_search(erased.begin(), erased.end(), entry.first);
+								if (gone) {
+									unindex_weights(src, entry.first, entry.second);
+								}
+								return gone;
+							});
+						}
+						it = adj.empty() ? edges_.erase(it) : ranges::next(it);
+					}
+				}
+				for (auto const* node : erased) {
+					nodes_.erase(nodes_.find(*node));
+				}
+			}
+			for (auto& [key, node] : states) {
+				if (node.alive) {
+					node.after = node.erasures.empty() && node.before != nullptr
+					                ? node.before
+					                : &*nodes_.insert(*key).first;
+				}
+			}
+
+			// Edges, in (src, dst, weight) order, so each source and destination is found once.
+			auto outer = edges_.end();
+			auto middle = typename adjacency::iterator();
+			auto const* current_src = static_cast<N const*>(nullptr);
+			auto const* current_dst = static_cast<N const*>(nullptr);
+			auto settle = [this, &outer, &middle, &current_dst](bool leaving_src) {
+				if (outer == edges_.end()) {
+					current_dst = nullptr;
+					return;
+				}
+				if (current_dst != nullptr && middle != outer->second.end() && middle->second.empty()) {
+					unlink(outer->first, middle->first);
+					outer->second.erase(middle);
+				}
+				current_dst = nullptr;
+				if (leaving_src && outer->second.empty()) {
+					edges_.erase(outer);
+					outer = edges_.end();
+				}
+			};
+			for (auto const& [operation, exists] : edges_after) {
+				auto const* src = operation->src->after;
+				auto const* dst = operation->dst->after;
+				if (src == nullptr || dst == nullptr) {
+					continue;
+				}
+				if (src != current_src) {
+					settle(true);
+					current_src = src;
+					outer = edges_.find(src);
+				}
+				if (outer == edges_.end()) {
+					if (!exists) {
+						continue;
+					}
+					outer = edges_.try_emplace(src).first;
+				}
+				if (dst != current_dst) {
+					settle(false);
+					current_dst = dst;
+					middle = outer->second.find(dst);
+				}
+				if (middle == outer->second.end()) {
+					if (!exists) {
+						continue;
+					}
+					middle = outer->second.try_emplace(dst).first;
+					link(src, dst, middle->second);
+				}
+				if (exists) {
+					auto const size = middle->second.size();
+					middle->second.insert(middle->second.end(), operation->op->weight);
+					index_weight(src, dst, operation->op->weight);
+					added_weight(operation->op->weight);
+					if (middle->second.size() != size) {
+						modified({src});
+					}
+				}
+				else if (middle->second.erase(operation->op->weight) != 0) {
+					unindex_weight(src, dst, operation->op->weight);
+					modified({src});
+				}
+			}
+			settle(true);
+
+			if (failure != nullptr) {
+				throw std::runtime_error(failure);
+			}
+			return results;
+		}
+
 		auto clear() noexcept -> void {
-			nodes_.clear();
+			auto const probe = instrument(graph_operation::clear);
+			++version_;
+			if (query_cache_) {
+				query_cache_->clear();
+			}
+			if (releases_without_destruction()) {
+				// Abandon the containers without visiting their elements, then drop the arena.
+				auto* arena = static_cast<std::pmr::monotonic_buffer_resource*>(owned_resource_.get());
+				auto* resource = allocation_resource();
+				std::construct_at(&nodes_, resource);
+				std::construct_at(&edges_, resource);
+				if (incoming_) {
+					std::construct_at(incoming_.get(), resource);
+				}
+				if (weight_index_) {
+					std::construct_at(weight_index_.get(), resource);
+				}
+				arena->release();
+				return;
+			}
+			if (incoming_) {
+				incoming_->clear();
+			}
+			if (weight_index_) {
+				weight_index_->clear();
+			}
 			edges_.clear();
+			nodes_.clear();
+		}
+
+		// Sizes the first block of an empty arena graph for about `edges` edges, so loading them
+		// doesn't grow the arena one block at a time. The node-based containers of the other
+		// storage modes have nothing to reserve, so for them this does nothing.
+		auto reserve(std::size_t edges) -> void {
+			if (storage_ != graph_storage::arena or !nodes_.empty()) {
+				return;
+			}
+			destroy_storage();
+			auto const indexed = incoming_ != nullptr;
+			auto const weight_indexed = weight_index_ != nullptr;
+			incoming_.reset();
+			weight_index_.reset();
+			owned_resource_ = std::make_unique<std::pmr::monotonic_buffer_resource>(
+			   std::max<std::size_t>(1, edges * bytes_per_edge));
+			auto* resource = instrument_resource(owned_resource_.get());
+			std::construct_at(&nodes_, resource);
+			std::construct_at(&edges_, resource);
+			if (indexed) {
+				incoming_ = std::make_unique<incoming_map>(resource);
+			}
+			if (weight_indexed) {
+				weight_index_ = std::make_unique<weight_index_set>(resource);
+			}
+		}
+
+		// The resource the graph was given or created. With instrumentation on, the containers
+		// reach it through the graph's counters.
+		[[nodiscard]] auto resource() const noexcept -> std::pmr::memory_resource* {
+			if constexpr (instrumentation_enabled) {
+				if (instrumentation_ != nullptr and allocation_resource() == instrumentation_.get()) {
+					return instrumentation_->upstream();
+				}
+			}
+			return allocation_resource();
+		}
+
+		[[nodiscard]] auto storage() const noexcept -> graph_storage {
+			return storage_;
 		}
 
 		// ======================================
 		//              Accessors
 		// ======================================
-		[[nodiscard]] auto is_node(N const& value) -> bool {
+		template<typename K = N>
+		requires node_key<K, N>
+		[[nodiscard]] auto is_node(K const& value) const -> bool {
+			auto const probe = instrument(graph_operation::is_node);
 			return static_cast<bool>(find_node_ptr(value) != nullptr);
 		}
 
-		[[nodiscard]] auto is_node(N const& value) const -> bool {
-			return static_cast<bool>(find_node_ptr(value) != nullptr);
-		}
-
-		[[nodiscard]] auto empty() -> bool {
-			return static_cast<bool>(nodes_.empty() && edges_.empty());
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return nodes_.empty();
 		}
 
-		[[nodiscard]] auto is_connected(N const& src, N const& dst) -> bool {
-			if (!is_node(src) || !is_node(dst)) {
+		template<typename K1 = N, typename K2 = N>
+		requires node_key<K1, N> and node_key<K2, N>
+		[[nodiscard]] auto is_connected(K1 const& src, K2 const& dst) const -> bool {
+			auto const probe = instrument(graph_operation::is_connected);
+			auto src_ptr = find_node_ptr(src);
+			auto dst_ptr = find_node_ptr(dst);
+			if (src_ptr == nullptr || dst_ptr == nullptr) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::is_connected if src or dst "
 				                         "node don't exist in the graph");
 			}
-			return !edges_[std::make_pair(find_node_ptr(src), find_node_ptr(dst))].empty();
+			auto outer = edges_.find(src_ptr);
+			return outer != edges_.end() && outer->second.contains(dst_ptr);
 		}
 
-		[[nodiscard]] auto nodes() -> std::vector<N> {
-			auto new_vector = std::vector<N>();
-			for (auto& temp : nodes_) {
-				new_vector.push_back(*temp.get());
-			}
-			std::sort(new_vector.begin(), new_vector.end());
-			return new_vector;
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			auto const probe = instrument(graph_operation::nodes);
+			auto view = nodes_view();
+			return std::vector<N>(view.begin(), view.end());
 		}
 
-		[[nodiscard]] auto nodes() const -> std::vector<N> {
-			auto new_vector = std::vector<N>();
-			for (auto& temp : nodes_) {
-				new_vector.push_back(*temp.get());
-			}
-			std::sort(new_vector.begin(), new_vector.end());
-			return new_vector;
+		// The *_view accessors are lazy views straight over the internal storage. They copy and
+		// allocate nothing, yield references in sorted order, and stay valid until the graph is
+		// next modified.
+		[[nodiscard]] auto nodes_view() const -> ranges::subrange<typename node_set::const_iterator> {
+			auto const probe = instrument(graph_operation::nodes_view);
+			return {nodes_.begin(), nodes_.end()};
 		}
-		[[nodiscard]] auto all_edges() -> std::map<std::pair<N, N>, std::set<E>> {
-			auto new_map = std::map<std::pair<N, N>, std::set<E>>();
-			for (auto& [key, values] : edges_) {
-				auto set_weights = std::set<E>();
-				for (auto& temp : values) {
-					set_weights.insert(*temp);
-				}
-				new_map[std::make_pair(*key.first, *key.second)] = set_weights;
-			}
-			return new_map;
+
+		// Every edge as (src, dst, weight), in the same order as begin() to end().
+		[[nodiscard]] auto edges_view() const -> ranges::subrange<iterator> {
+			auto const probe = instrument(graph_operation::edges_view);
+			return {begin(), end()};
 		}
 
+		template<typename K1 = N, typename K2 = N>
+		requires node_key<K1, N> and node_key<K2, N>
+		[[nodiscard]] auto weights_view(K1 const& from, K2 const& to) const
+		   -> ranges::subrange<typename weight_set::const_iterator> {
+			auto const probe = instrument(graph_operation::weights_view);
+			auto my_src = this->find_node_ptr(from);
+			auto my_dst = this->find_node_ptr(to);
+			if (my_src == nullptr || my_dst == nullptr) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::weights_view if src or dst "
+				                         "node don't exist in the graph");
+			}
+			auto const* weights = find_weights(my_src, my_dst);
+			if (weights == nullptr) {
+				return {};
+			}
+			return {weights->begin(), weights->end()};
+		}
 		[[nodiscard]] auto all_edges() const -> std::map<std::pair<N, N>, std::set<E>> {
+			auto const probe = instrument(graph_operation::all_edges);
 			auto new_map = std::map<std::pair<N, N>, std::set<E>>();
-			for (auto& [key, values] : edges_) {
-				auto set_weights = std::set<E>();
-				for (auto& temp : values) {
-					set_weights.insert(*temp);
+			for (auto& [src, adj] : edges_) {
+				for (auto& [dst, values] : adj) {
+					new_map[std::make_pair(*src, *dst)] = std::set<E>(values.begin(), values.end());
 				}
-				new_map[std::make_pair(*key.first, *key.second)] = set_weights;
 			}
 			return new_map;
 		}
 
-		[[nodiscard]] auto weights(N const& from, N const& to) -> std::vector<E> {
-			if (!is_node(from) || !is_node(to)) {
-				throw std::runtime_error("Cannot call gdwg::graph<N, E>::weights if src or dst node "
-				                         "don't exist in the graph");
-			}
-			auto result = std::vector<E>();
+		template<typename K1 = N, typename K2 = N>
+		requires node_key<K1, N> and node_key<K2, N>
+		[[nodiscard]] auto weights(K1 const& from, K2 const& to) const -> std::vector<E> {
+			auto const probe = instrument(graph_operation::weights);
 			auto my_src = this->find_node_ptr(from);
 			auto my_dst = this->find_node_ptr(to);
-			for (auto& temp : edges_[std::make_pair(my_src, my_dst)]) {
-				result.push_back(*temp.get());
+			if (my_src == nullptr || my_dst == nullptr) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::weights if src or dst node "
+				                         "don't exist in the graph");
 			}
-			std::sort(result.begin(), result.end());
-			return result;
+			auto const* weights = find_weights(my_src, my_dst);
+			return weights == nullptr ? std::vector<E>()
+			                          : std::vector<E>(weights->begin(), weights->end());
 		}
 
-		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) -> iterator {
-			for (auto temp = begin(); temp != end(); temp++) {
-				if (std::get<0>(*temp) == src && std::get<1>(*temp) == dst
-				    && std::get<2>(*temp) == weight) {
-					return temp;
-				}
+		template<typename K1 = N, typename K2 = N>
+		requires node_key<K1, N> and node_key<K2, N>
+		[[nodiscard]] auto find(K1 const& src, K2 const& dst, E const& weight) const -> iterator {
+			auto const probe = instrument(graph_operation::find);
+			auto src_ptr = find_node_ptr(src);
+			auto dst_ptr = find_node_ptr(dst);
+			if (src_ptr == nullptr || dst_ptr == nullptr) {
+				return end();
 			}
-			return end();
+			auto outer = edges_.find(src_ptr);
+			if (outer == edges_.end()) {
+				return end();
+			}
+			auto middle = outer->second.find(dst_ptr);
+			if (middle == outer->second.end()) {
+				return end();
+			}
+			auto inner = middle->second.find(weight);
+			if (inner == middle->second.end()) {
+				return end();
+			}
+			return iterator(edges_, outer, middle, inner);
 		}
 
-		[[nodiscard]] auto connections(N const& src) -> std::vector<N> {
-			if (!is_node(src)) {
+		template<typename K = N>
+		requires node_key<K, N>
+		[[nodiscard]] auto connections(K const& src) const -> std::vector<N> {
+			auto const probe = instrument(graph_operation::connections);
+			auto src_ptr = find_node_ptr(src);
+			if (src_ptr == nullptr) {
 				throw std::runtime_error("Cannot call gdwg::graph<N, E>::connections if src doesn't "
 				                         "exist in the graph");
 			}
-			auto result = std::set<N>();
-			for (auto& [key, value] : edges_) {
-				if (*key.first == src) {
-					result.insert(*key.second);
+			auto connections = [this, src_ptr] {
+				auto result = std::vector<N>();
+				auto outer = edges_.find(src_ptr);
+				if (outer == edges_.end()) {
+					return result;
 				}
+				// The adjacency is keyed by destination value, so it is already in sorted order.
+				result.reserve(outer->second.size());
+				for (auto& [dst, weights] : outer->second) {
+					result.push_back(*dst);
+				}
+				return result;
+			};
+			if (!query_cache_) {
+				return connections();
 			}
-			auto final_result = std::vector<N>(result.begin(), result.end());
-			std::sort(final_result.begin(), final_result.end());
+			// The result names the destinations, so it also depends on their values.
+			auto depends_on = [this, src_ptr](std::vector<N> const&) {
+				auto nodes = std::vector<N const*>{src_ptr};
+				if (auto outer = edges_.find(src_ptr); outer != edges_.end()) {
+					for (auto& [dst, weights] : outer->second) {
+						nodes.push_back(dst);
+					}
+				}
+				return nodes;
+			};
+			return query_cache_->template get<std::vector<N>>(cached_query::connections,
+			                                                  src_ptr,
+			                                                  connections,
+			                                                  depends_on);
+		}
 
-			return final_result;
+		[[nodiscard]] auto has_incoming_index() const noexcept -> bool {
+			return incoming_ != nullptr;
 		}
-		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
-			if (!is_node(src)) {
-				throw std::runtime_error("Cannot call gdwg::graph<N, E>::connections if src doesn't "
+
+		// The sources of every edge into dst, in sorted order. O(in-degree) with an incoming index,
+		// otherwise every source is searched.
+		template<typename K = N>
+		requires node_key<K, N>
+		[[nodiscard]] auto predecessors(K const& dst) const -> std::vector<N> {
+			auto const probe = instrument(graph_operation::predecessors);
+			auto dst_ptr = find_node_ptr(dst);
+			if (dst_ptr == nullptr) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::predecessors if dst doesn't "
+				                         "exist in the graph");
+			}
+			auto result = std::vector<N>();
+			for_each_incoming(dst_ptr, [&result](N const* src, weight_set const&) {
+				result.push_back(*src);
+			});
+			return result;
+		}
+
+		// The number of edges into dst, counting parallel edges separately.
+		template<typename K = N>
+		requires node_key<K, N>
+		[[nodiscard]] auto in_degree(K const& dst) const -> std::size_t {
+			auto const probe = instrument(graph_operation::in_degree);
+			auto dst_ptr = find_node_ptr(dst);
+			if (dst_ptr == nullptr) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::in_degree if dst doesn't "
 				                         "exist in the graph");
 			}
-			auto result = std::set<N>();
-			for (auto& [key, value] : edges_) {
-				if (*key.first == src) {
-					result.insert(*key.second);
+			auto result = std::size_t{0};
+			for_each_incoming(dst_ptr, [&result](N const*, weight_set const& weights) {
+				result += weights.size();
+			});
+			return result;
+		}
+
+		[[nodiscard]] auto has_weight_index() const noexcept -> bool {
+			return weight_index_ != nullptr;
+		}
+
+		// Every edge with a weight in [lo, hi], lightest first, with edges of equal weight in the
+		// order begin() to end() visits them. O(log E) plus O(1) per edge visited. Like the *_view
+		// accessors, the range is lazy and stays valid until the graph is next modified.
+		[[nodiscard]] auto edges_in_weight_range(E const& lo, E const& hi) const
+		   -> ranges::subrange<weight_iterator> {
+			auto const probe = instrument(graph_operation::edges_in_weight_range);
+			if (!weight_index_) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::edges_in_weight_range on a "
+				                         "graph without a weight index");
+			}
+			if (hi < lo) {
+				return {};
+			}
+			return {weight_iterator(weight_index_->lower_bound(lo), false),
+			        weight_iterator(weight_index_->upper_bound(hi), false)};
+		}
+
+		// The k lightest or heaviest edges, or every edge if there are fewer, starting from the
+		// extreme weight. The heaviest come in exactly the reverse of the lightest order.
+		// O(log E + k), and lazy in the same way as edges_in_weight_range().
+		[[nodiscard]] auto
+		top_k_edges(std::size_t k, weight_order order = weight_order::heaviest) const
+		   -> ranges::subrange<weight_iterator> {
+			auto const probe = instrument(graph_operation::top_k_edges);
+			if (!weight_index_) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::top_k_edges on a graph "
+				                         "without a weight index");
+			}
+			auto const count = static_cast<std::ptrdiff_t>(std::min(k, weight_index_->size()));
+			if (order == weight_order::lightest) {
+				auto const first = weight_index_->begin();
+				return {weight_iterator(first, false),
+				        weight_iterator(ranges::next(first, count), false)};
+			}
+			auto const last = weight_index_->end();
+			return {weight_iterator(last, true), weight_iterator(ranges::prev(last, count), true)};
+		}
+
+		// ======================================
+		//              Instrumentation
+		// ======================================
+
+		// What the graph has done since it was created or last reset; see graph_stats. Always
+		// empty unless GDWG_INSTRUMENTATION is defined to 1. A moved-to graph takes over the
+		// counters of the graph it was moved from, and a copy starts its own.
+		[[nodiscard]] auto stats() const -> graph_stats {
+			if constexpr (instrumentation_enabled) {
+				if (instrumentation_ != nullptr) {
+					return instrumentation_->snapshot();
 				}
 			}
-			auto final_result = std::vector<N>(result.begin(), result.end());
-			std::sort(final_result.begin(), final_result.end());
+			return graph_stats();
+		}
 
-			return final_result;
+		auto reset_stats() noexcept -> void {
+			if constexpr (instrumentation_enabled) {
+				if (instrumentation_ != nullptr) {
+					instrumentation_->reset();
+				}
+			}
+		}
+
+		// ======================================
+		//              Query Cache
+		// ======================================
+
+		// Bumped by every call that modifies the graph, so two equal versions of the same graph
+		// object are guaranteed to hold the same nodes and edges.
+		[[nodiscard]] auto version() const noexcept -> std::uint64_t {
+			return version_;
+		}
+
+		// Starts caching the results of connections() and of bfs, parallel_bfs, dfs, dijkstra and
+		// bellman_ford from a single source. A result is dropped only when one of the nodes it was
+		// worked out from is modified: its value, its outgoing edges, or whether it exists. So
+		// results for parts of the graph a modification didn't reach stay cached, and repeating
+		// such a query costs a hash lookup and a copy of its result.
+		auto enable_query_cache() -> void {
+			if (!query_cache_) {
+				query_cache_ = std::make_unique<detail::query_cache<N>>();
+			}
+		}
+
+		auto disable_query_cache() noexcept -> void {
+			query_cache_.reset();
+		}
+
+		[[nodiscard]] auto has_query_cache() const noexcept -> bool {
+			return query_cache_ != nullptr;
+		}
+
+		// Hits, misses and invalidations since the cache was enabled. All zero without one.
+		[[nodiscard]] auto cache_stats() const -> query_cache_stats {
+			return query_cache_ ? query_cache_->stats() : query_cache_stats();
 		}
 
 		// ======================================
 		//              Range Access
 		// ======================================
 		[[nodiscard]] auto begin() const -> iterator {
-			auto inner = edges_.empty() ? decltype(edges_.begin()->second.begin()){}
-			                            : edges_.begin()->second.begin();
-			return iterator(edges_, edges_.begin(), inner);
+			auto const probe = instrument(graph_operation::begin);
+			if (edges_.empty()) {
+				return end();
+			}
+			auto middle = edges_.begin()->second.begin();
+			return iterator(edges_, edges_.begin(), middle, middle->second.begin());
 		}
 
 		[[nodiscard]] auto end() const -> iterator {
-			return iterator(edges_, edges_.end(), {});
+			auto const probe = instrument(graph_operation::end);
+			return iterator(edges_, edges_.end(), {}, {});
 		}
 
 		// ======================================
 		//              Comparisons
 		// ======================================
 		[[nodiscard]] auto operator==(graph const& other) const -> bool {
-			return static_cast<bool>(this->nodes() == other.nodes()
-			                         && this->all_edges() == other.all_edges());
+			auto const probe = instrument(graph_operation::equals);
+			return ranges::equal(nodes_view(), other.nodes_view())
+			       && ranges::equal(edges_view(), other.edges_view());
 		}
 
 		// ======================================
 		//              Extractor
 		// ======================================
+		// Each node on a line of its own as `node (`, then each outgoing edge as `  dst | weight`,
+		// then `)`. The text is formatted into a buffer and written out in large blocks.
 		friend auto operator<<(std::ostream& os, graph const& g) -> std::ostream& {
-			auto g_nodes = g.nodes();
-			auto g_edges = g.all_edges();
-
-			for (auto node : g_nodes) {
-				os << node << " (" << std::endl;
-				auto g_conn = g.connections(node);
-				for (auto connects : g_conn) {
-					for (auto edge : g_edges[std::make_pair(node, connects)]) {
-						os << "  " << connects << " | " << edge << std::endl;
-					}
+			auto const probe = g.instrument(graph_operation::output);
+			auto buffer = detail::text_buffer(os);
+			g.format_text(buffer, g.nodes_.begin(), g.nodes_.end(), g.edges_.begin(), &os);
+			buffer.write_to(os);
+			os.width(0);
+			return os;
+		}
+
+		// Writes the same text as operator<<, with blocks of nodes formatted on up to `threads`
+		// threads (0 for one per hardware thread) and written out in order. A stream that isn't in
+		// its default formatting state is written on the calling thread.
+		auto write_text(std::ostream& os, std::size_t threads = 0) const -> void {
+			auto const probe = instrument(graph_operation::write_text);
+			if (threads == 0) {
+				threads = detail::hardware_threads();
+			}
+			if (threads == 1 or nodes_.size() < detail::parallel_threshold
+			    or not detail::text_buffer::has_default_format(os))
+			{
+				os << *this;
+				return;
+			}
+
+			constexpr auto block_nodes = std::size_t{1024};
+			auto starts = std::vector<typename node_set::const_iterator>();
+			starts.reserve(nodes_.size() / block_nodes + 2);
+			auto count = std::size_t{0};
+			for (auto it = nodes_.begin(); it != nodes_.end(); ++it, ++count) {
+				if (count % block_nodes == 0) {
+					starts.push_back(it);
 				}
-				os << ")" << std::endl;
 			}
+			starts.push_back(nodes_.end());
 
-			return os;
+			// One round formats a block per thread, so no more than that is ever held in memory.
+			auto buffers = std::vector<detail::text_buffer>();
+			buffers.reserve(threads);
+			for (auto i = std::size_t{0}; i < threads; ++i) {
+				buffers.emplace_back(os);
+			}
+			auto const blocks = starts.size() - 1;
+			for (auto round = std::size_t{0}; round < blocks; round += threads) {
+				auto const size = std::min(threads, blocks - round);
+				auto format = [&](std::size_t first, std::size_t last, std::size_t) {
+					for (auto block = first; block != last; ++block) {
+						auto const node = starts[round + block];
+						format_text(buffers[block],
+						            node,
+						            starts[round + block + 1],
+						            edges_.lower_bound(&*node),
+						            nullptr);
+					}
+				};
+				detail::for_each_chunk(size, size, format);
+				for (auto block = std::size_t{0}; block < size; ++block) {
+					buffers[block].write_to(os);
+				}
+			}
 		}
+
 		// ======================================
 		//              Iterators
 		// ======================================
 
 		// I reused some of code from rope_q33 and rope_q54 from tutorials for the iterators section
 		class iterator {
-			using outer_iterator =
-			   typename std::map<std::pair<N*, N*>, std::set<std::unique_ptr<E>>>::const_iterator;
-			using inner_iterator = typename std::set<std::unique_ptr<E>>::const_iterator;
+			using outer_iterator = typename edge_map::const_iterator;
+			using middle_iterator = typename adjacency::const_iterator;
+			using inner_iterator = typename weight_set::const_iterator;
 
 		public:
 			using value_type = ranges::common_tuple<N, N, E>;
@@ -464,22 +1431,28 @@ namespace gdwg {
 			iterator() = default;
 
 			// Iterator source
-			auto operator*() -> ranges::common_tuple<N const&, N const&, E const&> {
-				return ranges::common_tuple<N const&, N const&, E const&>{*outer_->first.first,
-				                                                          *outer_->first.second,
-				                                                          **inner_};
+			auto operator*() const -> ranges::common_tuple<N const&, N const&, E const&> {
+				return ranges::common_tuple<N const&, N const&, E const&>{*outer_->first,
+				                                                          *middle_->first,
+				                                                          *inner_};
 			};
 
 			// Iterator traversal
 			auto operator++() -> iterator& {
-				if (inner_ != outer_->second.end()) {
-					++inner_;
-					if (inner_ != outer_->second.end()) {
-						return *this;
-					}
+				if (++inner_ != middle_->second.end()) {
+					return *this;
+				}
+				if (++middle_ != outer_->second.end()) {
+					inner_ = middle_->second.begin();
+					return *this;
 				}
-				++outer_;
-				inner_ = outer_ == pointee_->end() ? inner_iterator() : outer_->second.begin();
+				if (++outer_ == pointee_->end()) {
+					middle_ = middle_iterator();
+					inner_ = inner_iterator();
+					return *this;
+				}
+				middle_ = outer_->second.begin();
+				inner_ = middle_->second.begin();
 				return *this;
 			};
 			auto operator++(int) -> iterator {
@@ -488,19 +1461,24 @@ namespace gdwg {
 				return temp;
 			}
 			auto operator--() -> iterator& {
-				if (inner_ == inner_iterator()) {
+				if (outer_ == pointee_->end()) {
 					outer_ = ranges::prev(pointee_->end());
-					inner_ = ranges::prev(outer_->second.end());
+					middle_ = ranges::prev(outer_->second.end());
+					inner_ = ranges::prev(middle_->second.end());
 					return *this;
 				}
 
-				if (inner_ != outer_->second.begin()) {
+				if (inner_ != middle_->second.begin()) {
 					--inner_;
 					return *this;
 				}
 
-				--outer_;
-				inner_ = ranges::prev(outer_->second.end());
+				if (middle_ == outer_->second.begin()) {
+					--outer_;
+					middle_ = outer_->second.end();
+				}
+				--middle_;
+				inner_ = ranges::prev(middle_->second.end());
 				return *this;
 			}
 			auto operator--(int) -> iterator {
@@ -513,54 +1491,576 @@ namespace gdwg {
 			auto operator==(iterator const& other) const -> bool = default;
 
 		private:
-			std::map<std::pair<N*, N*>, std::set<std::unique_ptr<E>>, pair_cmp> const* pointee_ =
-			   nullptr;
+			edge_map const* pointee_ = nullptr;
 			outer_iterator outer_;
+			middle_iterator middle_;
 			inner_iterator inner_;
 			friend class graph;
-			explicit iterator(
-			   std::map<std::pair<N*, N*>, std::set<std::unique_ptr<E>>, pair_cmp> const& pointee,
-			   outer_iterator outer,
-			   inner_iterator inner) noexcept
+			explicit iterator(edge_map const& pointee,
+			                  outer_iterator outer,
+			                  middle_iterator middle,
+			                  inner_iterator inner) noexcept
 			: pointee_(&pointee)
 			, outer_(outer)
+			, middle_(middle)
 			, inner_(inner) {}
 		};
 
+		// Walks the weight index either way, yielding the same (src, dst, weight) as iterator. A
+		// descending iterator refers to the entry before its position, as std::reverse_iterator
+		// does, so the end of the index can start a walk down from the heaviest edge.
+		class weight_iterator {
+			using index_iterator = typename weight_index_set::const_iterator;
+
+		public:
+			using value_type = ranges::common_tuple<N, N, E>;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			weight_iterator() = default;
+
+			auto operator*() const -> ranges::common_tuple<N const&, N const&, E const&> {
+				auto const& entry = descending_ ? *ranges::prev(position_) : *position_;
+				return ranges::common_tuple<N const&, N const&, E const&>{*entry.src,
+				                                                          *entry.dst,
+				                                                          entry.weight};
+			}
+
+			auto operator++() -> weight_iterator& {
+				descending_ ? --position_ : ++position_;
+				return *this;
+			}
+			auto operator++(int) -> weight_iterator {
+				auto temp = *this;
+				++*this;
+				return temp;
+			}
+			auto operator--() -> weight_iterator& {
+				descending_ ? ++position_ : --position_;
+				return *this;
+			}
+			auto operator--(int) -> weight_iterator {
+				auto temp = *this;
+				--*this;
+				return temp;
+			}
+
+			auto operator==(weight_iterator const& other) const -> bool = default;
+
+		private:
+			index_iterator position_;
+			bool descending_ = false;
+			friend class graph;
+			explicit weight_iterator(index_iterator position, bool descending) noexcept
+			: position_(position)
+			, descending_(descending) {}
+		};
+
 	private:
-		std::set<std::unique_ptr<N>> nodes_;
-		std::map<std::pair<N*, N*>, std::set<std::unique_ptr<E>>, pair_cmp> edges_;
+		// Only set for graph_storage::arena and graph_storage::pool; declared before the containers
+		// so it is created first.
+		std::unique_ptr<std::pmr::memory_resource> owned_resource_;
+		graph_storage storage_ = graph_storage::heap;
+		// The counters, which the containers allocate through, so likewise declared before them.
+		[[no_unique_address]] detail::instrumentation_handle instrumentation_;
+
+		// The containers live in anonymous unions so that an arena graph can skip their destructors
+		// and reclaim everything by releasing the arena. Every constructor initialises them.
+		union {
+			// Ordered by value with a transparent comparator, so any key comparable with N can be
+			// used for lookup without first constructing an N.
+			node_set nodes_;
+		};
+		union {
+			edge_map edges_;
+		};
+		// Only set for graphs constructed with incoming_index; draws from the same resource as the
+		// containers, so it is declared after the owned resource and released before it.
+		std::unique_ptr<incoming_map> incoming_;
+		// Only set for graphs constructed with weight_index, and held the same way.
+		std::unique_ptr<weight_index_set> weight_index_;
+		// Only set once enable_query_cache is called. It holds the addresses of nodes, but none of
+		// the graph's memory.
+		std::unique_ptr<detail::query_cache<N>> query_cache_;
+		std::uint64_t version_ = 0;
+
+		static auto make_resource(graph_storage storage)
+		   -> std::unique_ptr<std::pmr::memory_resource> {
+			switch (storage) {
+			case graph_storage::arena: return std::make_unique<std::pmr::monotonic_buffer_resource>();
+			case graph_storage::pool: return std::make_unique<std::pmr::unsynchronized_pool_resource>();
+			case graph_storage::heap: break;
+			}
+			return nullptr;
+		}
 
-		auto find_node_ptr(N node) -> N* {
-			auto node_ptr = [node](auto& node_value) { return node == *node_value; };
-			auto result = find_if(nodes_.begin(), nodes_.end(), node_ptr);
-			if (result == nodes_.end()) {
-				return nullptr;
+		static auto resource_for(std::pmr::memory_resource* owned) noexcept
+		   -> std::pmr::memory_resource* {
+			return owned != nullptr ? owned : std::pmr::get_default_resource();
+		}
+
+		// The resource for new containers over `upstream`: with instrumentation on, the graph's
+		// counters in front of it, created on first use. Must only be called while there are no
+		// containers allocating from a previous upstream. A graph whose counters can't be
+		// allocated still works, uncounted.
+		auto instrument_resource(std::pmr::memory_resource* upstream) noexcept
+		   -> std::pmr::memory_resource* {
+			if constexpr (instrumentation_enabled) {
+				if (instrumentation_ == nullptr) {
+					instrumentation_.reset(new (std::nothrow) detail::graph_instrumentation(upstream));
+					if (instrumentation_ == nullptr) {
+						return upstream;
+					}
+				}
+				instrumentation_->set_upstream(upstream);
+				return instrumentation_.get();
+			}
+			else {
+				return upstream;
 			}
-			auto& temp = *result;
-			return temp.get();
 		}
 
-		auto find_node_ptr(N node) const -> N* {
-			auto node_ptr = [node](auto& node_value) { return node == *node_value; };
-			auto result = find_if(nodes_.begin(), nodes_.end(), node_ptr);
-			if (result == nodes_.end()) {
+		// The resource the containers actually allocate from.
+		[[nodiscard]] auto allocation_resource() const noexcept -> std::pmr::memory_resource* {
+			return nodes_.get_allocator().resource();
+		}
+
+		// Times the calling public member for stats(); see detail::basic_probe.
+		[[nodiscard]] auto instrument(graph_operation op) const noexcept -> detail::probe {
+			return detail::probe(instrumentation_.get(), op);
+		}
+
+		// A rough arena cost per edge: at worst, its own adjacency entry holding the weight inline.
+		static constexpr auto tree_node_overhead = 4 * sizeof(void*);
+		static constexpr auto bytes_per_edge =
+		   tree_node_overhead + sizeof(N const*) + sizeof(weight_set);
+
+		[[nodiscard]] auto releases_without_destruction() const noexcept -> bool {
+			return storage_ == graph_storage::arena and arena_releasable<N> and arena_releasable<E>;
+		}
+
+		// Ends the containers' lifetimes. The owned resource is left for the caller to drop.
+		auto destroy_storage() noexcept -> void {
+			if (!releases_without_destruction()) {
+				std::destroy_at(&edges_);
+				std::destroy_at(&nodes_);
+				return;
+			}
+			// The arena's memory goes with the resource, so the indexes are abandoned like clear()
+			// abandons them, and whoever drops them then frees nothing element by element.
+			auto* resource = allocation_resource();
+			if (incoming_) {
+				std::construct_at(incoming_.get(), resource);
+			}
+			if (weight_index_) {
+				std::construct_at(weight_index_.get(), resource);
+			}
+		}
+
+		// Replaces the (empty, moved-from) containers with fresh ones on the default resource.
+		auto reset_storage() noexcept -> void {
+			std::destroy_at(&edges_);
+			std::destroy_at(&nodes_);
+			incoming_.reset();
+			weight_index_.reset();
+			query_cache_.reset();
+			++version_;
+			owned_resource_.reset();
+			storage_ = graph_storage::heap;
+			std::construct_at(&nodes_, instrument_resource(std::pmr::get_default_resource()));
+			std::construct_at(&edges_, allocation_resource());
+		}
+
+		// The result of compute(), which runs `query` from `src`, through the query cache. Every
+		// node the result depends on has to be passed to `note` by depends_on(result, note): for
+		// a search, every node it reached. Without a cache, or a node `src`, this is compute().
+		// The algorithms reach it through detail::cache_access.
+		template<typename K, typename Compute, typename DependsOn>
+		requires node_key<K, N>
+		auto cached(cached_query query,
+		            K const& src,
+		            DependsOn const& depends_on,
+		            Compute const& compute) const -> std::invoke_result_t<Compute const&> {
+			using result_type = std::invoke_result_t<Compute const&>;
+			auto const* src_ptr = query_cache_ ? find_node_ptr(src) : nullptr;
+			if (src_ptr == nullptr) {
+				return compute();
+			}
+			return query_cache_->template get<result_type>(
+			   query,
+			   src_ptr,
+			   compute,
+			   [this, src_ptr, &depends_on](result_type const& result) {
+				   auto nodes = std::vector<N const*>{src_ptr};
+				   depends_on(result, [this, &nodes](N const& node) {
+					   if (auto const* node_ptr = find_node_ptr(node); node_ptr != nullptr) {
+						   nodes.push_back(node_ptr);
+					   }
+				   });
+				   return nodes;
+			   });
+		}
+
+		// The result of `query` from `src` if the query cache holds one. It never runs the query.
+		template<typename R, typename K>
+		requires node_key<K, N>
+		auto cached_result(cached_query query, K const& src) const -> std::shared_ptr<R const> {
+			auto const* src_ptr = query_cache_ ? find_node_ptr(src) : nullptr;
+			return src_ptr == nullptr ? nullptr : query_cache_->template find<R>(query, src_ptr);
+		}
+
+		// Record a modification to the graph that changes `nodes`: their values, whether they exist,
+		// or their outgoing edges. Cached results that depend on any of them are dropped.
+		auto modified(std::span<N const* const> nodes = {}) -> void {
+			++version_;
+			if (query_cache_) {
+				for (auto const* node : nodes) {
+					query_cache_->invalidate(node);
+				}
+			}
+		}
+
+		auto modified(std::initializer_list<N const*> nodes) -> void {
+			modified(std::span<N const* const>(nodes.begin(), nodes.size()));
+		}
+
+		// Record that `weight` went into the graph. dijkstra refuses a graph with any negative
+		// weight, so a negative one drops every cached dijkstra result, whichever nodes it reached.
+		auto added_weight(E const& weight) noexcept -> void {
+			if constexpr (std::is_signed_v<E>) {
+				if (query_cache_ and weight < E{}) {
+					query_cache_->invalidate(cached_query::dijkstra);
+				}
+			}
+		}
+
+		// Record that edges_ gained or lost its (src, dst) entry. Without an index they do nothing.
+		auto link(N const* src, N const* dst, weight_set const& weights) -> void {
+			if (incoming_) {
+				(*incoming_)[dst].insert_or_assign(src, &weights);
+			}
+		}
+
+		auto unlink(N const* src, N const* dst) -> void {
+			if (!incoming_) {
+				return;
+			}
+			if (auto in = incoming_->find(dst); in != incoming_->end()) {
+				in->second.erase(src);
+				if (in->second.empty()) {
+					incoming_->erase(in);
+				}
+			}
+		}
+
+		// Record that an edge gained or lost a weight. Without a weight index they do nothing.
+		auto index_weight(N const* src, N const* dst, E const& weight) -> void {
+			if (weight_index_) {
+				weight_index_->insert(weight_entry{weight, src, dst});
+			}
+		}
+
+		auto unindex_weight(N const* src, N const* dst, E const& weight) -> void {
+			if (weight_index_) {
+				weight_index_->erase(weight_entry{weight, src, dst});
+			}
+		}
+
+		auto unindex_weights(N const* src, N const* dst, weight_set const& weights) -> void {
+			if (weight_index_) {
+				for (auto const& weight : weights) {
+					weight_index_->erase(weight_entry{weight, src, dst});
+				}
+			}
+		}
+
+		auto unindex_adjacency(N const* src, adjacency const& adj) -> void {
+			if (weight_index_) {
+				for (auto const& [dst, weights] : adj) {
+					unindex_weights(src, dst, weights);
+				}
+			}
+		}
+
+		// Re-points the index entries of the edges (src, dst, weights) at (to_src, to_dst), reusing
+		// their allocations. Call it before the weights are merged into their new pair: an entry
+		// the new pair already has is dropped, just as merge_weights drops the weight.
+		auto move_weight_entries(N const* src,
+		                         N const* dst,
+		                         weight_set const& weights,
+		                         N const* to_src,
+		                         N const* to_dst) -> void {
+			if (!weight_index_) {
+				return;
+			}
+			for (auto const& weight : weights) {
+				auto entry = weight_index_->extract(weight_entry{weight, src, dst});
+				if (!entry.empty()) {
+					entry.value().src = to_src;
+					entry.value().dst = to_dst;
+					weight_index_->insert(std::move(entry));
+				}
+			}
+		}
+
+		// Pulls every index entry of an edge into or out of node out of the index, so node can be
+		// renamed without breaking its order. They go back in with weight_index_->insert.
+		auto extract_weight_entries(N const* node)
+		   -> std::vector<typename weight_index_set::node_type> {
+			auto result = std::vector<typename weight_index_set::node_type>();
+			if (!weight_index_) {
+				return result;
+			}
+			auto take = [this, &result](N const* src, N const* dst, weight_set const& weights) {
+				for (auto const& weight : weights) {
+					result.push_back(weight_index_->extract(weight_entry{weight, src, dst}));
+				}
+			};
+			if (auto outer = edges_.find(node); outer != edges_.end()) {
+				for (auto const& [dst, weights] : outer->second) {
+					take(node, dst, weights);
+				}
+			}
+			for_each_incoming(node, [node, &take](N const* src, weight_set const& weights) {
+				// A self-loop went with the outgoing edges.
+				if (src != node) {
+					take(src, node, weights);
+				}
+			});
+			return result;
+		}
+
+		// Formats the nodes in [first, last) as operator<< writes them. nodes_ and edges_ are both
+		// ordered by node value, so they are walked in lockstep from `outer`, the first source not
+		// before `first`. With a stream, the buffer is written out whenever it fills.
+		auto format_text(detail::text_buffer& buffer,
+		                 typename node_set::const_iterator first,
+		                 typename node_set::const_iterator last,
+		                 typename edge_map::const_iterator outer,
+		                 std::ostream* os) const -> void {
+			for (; first != last; ++first) {
+				buffer.append_value(*first);
+				buffer.append_text(" (\n");
+				if (outer != edges_.end() && outer->first == &*first) {
+					for (auto const& [dst, weights] : outer->second) {
+						for (auto const& edge : weights) {
+							buffer.append_text("  ");
+							buffer.append_value(*dst);
+							buffer.append_text(" | ");
+							buffer.append_value(edge);
+							buffer.append_text("\n");
+						}
+					}
+					++outer;
+				}
+				buffer.append_text(")\n");
+				if (os != nullptr && buffer.size() >= detail::text_buffer::flush_size) {
+					buffer.write_to(*os);
+				}
+			}
+		}
+
+		// Calls f(src, weights) for every source with edges into dst, in order of src.
+		template<typename F>
+		auto for_each_incoming(N const* dst, F f) const -> void {
+			if (incoming_) {
+				if (auto in = incoming_->find(dst); in != incoming_->end()) {
+					for (auto const& [src, weights] : in->second) {
+						f(src, *weights);
+					}
+				}
+				return;
+			}
+			detail::count_adjacency_scans(edges_.size());
+			for (auto const& [src, adj] : edges_) {
+				if (auto middle = adj.find(dst); middle != adj.end()) {
+					f(src, middle->second);
+				}
+			}
+		}
+
+		// Removes every edge into or out of node. With an incoming index only the node's own edges
+		// are visited; without one, every source has to be searched.
+		auto detach(N const* node) -> void {
+			if (auto outer = edges_.find(node); outer != edges_.end()) {
+				unindex_adjacency(node, outer->second);
+				for (auto const& [dst, weights] : outer->second) {
+					if (incoming_ and dst != node) {
+						unlink(node, dst);
+					}
+				}
+				edges_.erase(outer);
+			}
+			if (!incoming_) {
+				detail::count_adjacency_scans(edges_.size());
+				for (auto it = edges_.begin(); it != edges_.end();) {
+					if (auto middle = it->second.find(node); middle != it->second.end()) {
+						unindex_weights(it->first, node, middle->second);
+						it->second.erase(middle);
+					}
+					it = it->second.empty() ? edges_.erase(it) : ranges::next(it);
+				}
+				return;
+			}
+			if (auto in = incoming_->find(node); in != incoming_->end()) {
+				for (auto const& [src, weights] : in->second) {
+					// A self-loop went with the outgoing edges.
+					if (src == node) {
+						continue;
+					}
+					auto outer = edges_.find(src);
+					unindex_weights(src, node, *weights);
+					outer->second.erase(node);
+					if (outer->second.empty()) {
+						edges_.erase(outer);
+					}
+				}
+				incoming_->erase(in);
+			}
+		}
+
+		// Copies the structure of `other` into this empty graph in O(V + E). The containers are
+		// already in order, so every element goes in with an end hint, and the edges' node pointers
+		// are translated to our own copies of the nodes through a table built alongside them. An
+		// incoming index is filled in as the edges go in, and a weight index is copied straight
+		// across, as translating its node pointers keeps it in order.
+		auto clone_from(graph const& other) -> void {
+			auto translation = std::unordered_map<N const*, N const*>();
+			translation.reserve(other.nodes_.size());
+			for (auto const& node : other.nodes_) {
+				translation.emplace(&node, &*nodes_.emplace_hint(nodes_.end(), node));
+			}
+			for (auto const& [src, adj] : other.edges_) {
+				auto const* copy_src = translation.at(src);
+				auto& copy = edges_.try_emplace(edges_.end(), copy_src)->second;
+				for (auto const& [dst, weights] : adj) {
+					auto const* copy_dst = translation.at(dst);
+					link(copy_src, copy_dst, copy.try_emplace(copy.end(), copy_dst, weights)->second);
+				}
+			}
+			if (weight_index_ and other.weight_index_) {
+				for (auto const& [weight, src, dst] : *other.weight_index_) {
+					auto entry = weight_entry{weight, translation.at(src), translation.at(dst)};
+					weight_index_->insert(weight_index_->end(), std::move(entry));
+				}
+			}
+		}
+
+		template<typename K>
+		auto find_node_ptr(K const& node) const -> N const* {
+			detail::count_lookup();
+			auto result = nodes_.find(node);
+			return result == nodes_.end() ? nullptr : &*result;
+		}
+
+		auto find_weights(N const* src, N const* dst) const -> weight_set const* {
+			auto outer = edges_.find(src);
+			if (outer == edges_.end()) {
 				return nullptr;
 			}
-			auto& temp = *result;
-			return temp.get();
+			auto middle = outer->second.find(dst);
+			return middle == outer->second.end() ? nullptr : &middle->second;
 		}
 
-		auto edge_exist(N* src, N* dst, E weight) -> bool {
-			for (auto& temp : edges_[std::make_pair(src, dst)]) {
-				if (weight == *temp.get()) {
-					return true;
+		// Fills the graph from edges sorted by (from, to, weight). Sources, destinations and weights
+		// then all arrive in order and go in through end hints, and a run of edges sharing a source
+		// or destination looks it up only once. Lookups binary-search an array of the endpoint
+		// nodes, which were allocated in order, rather than chase pointers down the node tree. Every
+		// hint is checked, so edges out of order or repeated only cost the full insertion, and the
+		// indexes and version are kept in step as they are by insert_edge.
+		template<typename I, typename S>
+		auto bulk_load(I first, S last, std::size_t size_hint) -> void {
+			reserve(size_hint);
+			auto endpoints = std::vector<N>();
+			endpoints.reserve(2 * size_hint);
+			for (auto it = first; it != last; ++it) {
+				auto const& [from, to, weight] = *it;
+				if (endpoints.empty() or endpoints.back() != from) {
+					endpoints.push_back(from);
 				}
+				endpoints.push_back(to);
 			}
-			return false;
+			std::sort(endpoints.begin(), endpoints.end());
+			endpoints.erase(std::unique(endpoints.begin(), endpoints.end()), endpoints.end());
+			auto endpoint_ptrs = std::vector<N const*>();
+			endpoint_ptrs.reserve(endpoints.size());
+			for (auto& node : endpoints) {
+				endpoint_ptrs.push_back(&*nodes_.insert(nodes_.end(), std::move(node)));
+			}
+			auto locate = [&endpoint_ptrs](N const& value) {
+				auto const less = [](N const* node, N const& v) { return *node < v; };
+				return *std::lower_bound(endpoint_ptrs.begin(), endpoint_ptrs.end(), value, less);
+			};
+
+			auto src = static_cast<N const*>(nullptr);
+			auto dst = static_cast<N const*>(nullptr);
+			auto outer = edges_.end();
+			auto middle = typename adjacency::iterator();
+			for (; first != last; ++first) {
+				auto const& [from, to, weight] = *first;
+				if (src == nullptr or *src != from) {
+					src = locate(from);
+					outer = edges_.try_emplace(edges_.end(), src);
+					dst = nullptr;
+				}
+				if (dst == nullptr or *dst != to) {
+					dst = locate(to);
+					middle = outer->second.try_emplace(outer->second.end(), dst);
+					link(src, dst, middle->second);
+				}
+				auto const size = middle->second.size();
+				middle->second.insert(middle->second.end(), weight);
+				if (middle->second.size() != size) {
+					index_weight(src, dst, weight);
+					added_weight(weight);
+				}
+			}
+			modified(endpoint_ptrs);
+		}
+
+		// Moves every weight of `from` that `into` doesn't already hold; duplicates are dropped.
+		static auto merge_weights(weight_set& into, weight_set& from) -> void {
+			into.merge(from);
 		}
+
+		friend struct detail::cache_access;
 	};
 
+	namespace detail {
+		// Runs the algorithms' single-source queries through a graph's query cache, which the graph
+		// keeps out of its public interface.
+		struct cache_access {
+			template<typename N, typename E, typename K, typename DependsOn, typename Compute>
+			static auto cached(graph<N, E> const& g,
+			                   cached_query query,
+			                   K const& src,
+			                   DependsOn const& depends_on,
+			                   Compute const& compute) {
+				return g.cached(query, src, depends_on, compute);
+			}
+
+			template<typename R, typename N, typename E, typename K>
+			static auto cached_result(graph<N, E> const& g, cached_query query, K const& src) {
+				return g.template cached_result<R>(query, src);
+			}
+		};
+
+		template<typename N, typename E, typename K, typename DependsOn, typename Compute>
+		auto cached(graph<N, E> const& g,
+		            cached_query query,
+		            K const& src,
+		            DependsOn const& depends_on,
+		            Compute const& compute) {
+			return cache_access::cached(g, query, src, depends_on, compute);
+		}
+
+		template<typename R, typename N, typename E, typename K>
+		auto cached_result(graph<N, E> const& g, cached_query query, K const& src)
+		   -> std::shared_ptr<R const> {
+			return cache_access::cached_result<R>(g, query, src);
+		}
+	} // namespace detail
+
 } // namespace gdwg
 
 #endif // GDWG_GRAPH_HPP
@@ -0,0 +1,538 @@
+#ifndef GDWG_GRAPH_ALGORITHMS_HPP
+#define GDWG_GRAPH_ALGORITHMS_HPP
+
+#include "gdwg/graph.hpp"
+#include "gdwg/parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	namespace detail {
+		// A flat, index-based copy of a graph's structure for the traversals. Weights play no part,
+		// so parallel edges collapse into one. Incoming edges are only indexed on request, for the
+		// algorithms that walk edges backwards.
+		template<typename N>
+		class traversal_index {
+		public:
+			static constexpr auto npos = static_cast<std::size_t>(-1);
+
+			template<typename E>
+			explicit traversal_index(graph<N, E> const& g, bool with_incoming = false) {
+				for (auto const& node : g.nodes_view()) {
+					nodes_.push_back(&node);
+				}
+				out_offsets_.reserve(nodes_.size() + 1);
+				out_offsets_.push_back(0);
+				// Edges arrive ordered by (src, dst), and nodes are unique by value, so comparing
+				// addresses finds repeated pairs.
+				auto src = std::size_t{0};
+				auto last_dst = static_cast<N const*>(nullptr);
+				for (auto const& [from, to, weight] : g.edges_view()) {
+					if (nodes_[src] != &from) {
+						while (nodes_[src] != &from) {
+							out_offsets_.push_back(out_.size());
+							++src;
+						}
+						last_dst = nullptr;
+					}
+					if (last_dst == &to) {
+						continue;
+					}
+					last_dst = &to;
+					out_.push_back(find(to));
+				}
+				while (out_offsets_.size() < nodes_.size() + 1) {
+					out_offsets_.push_back(out_.size());
+				}
+				if (with_incoming) {
+					index_incoming();
+				}
+			}
+
+			template<typename K>
+			[[nodiscard]] auto find(K const& value) const -> std::size_t {
+				auto result = std::lower_bound(nodes_.begin(),
+				                               nodes_.end(),
+				                               value,
+				                               [](N const* node, K const& key) { return *node < key; });
+				if (result == nodes_.end() || **result != value) {
+					return npos;
+				}
+				return static_cast<std::size_t>(result - nodes_.begin());
+			}
+
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return nodes_.size();
+			}
+
+			[[nodiscard]] auto edge_count() const noexcept -> std::size_t {
+				return out_.size();
+			}
+
+			[[nodiscard]] auto node(std::size_t i) const -> N const& {
+				return *nodes_[i];
+			}
+
+			// Calls f(dst) for every distinct successor of src, in ascending order.
+			template<typename F>
+			auto for_each_successor(std::size_t src, F&& f) const -> void {
+				for (auto i = out_offsets_[src]; i != out_offsets_[src + 1]; ++i) {
+					f(out_[i]);
+				}
+			}
+
+			// Calls f(src) for every distinct predecessor of dst, in ascending order. Requires the
+			// index to have been built with incoming edges.
+			template<typename F>
+			auto for_each_predecessor(std::size_t dst, F&& f) const -> void {
+				for (auto i = in_offsets_[dst]; i != in_offsets_[dst + 1]; ++i) {
+					f(in_[i]);
+				}
+			}
+
+			[[nodiscard]] auto successor(std::size_t src, std::size_t nth) const -> std::size_t {
+				return out_[out_offsets_[src] + nth];
+			}
+
+			[[nodiscard]] auto out_degree(std::size_t src) const -> std::size_t {
+				return out_offsets_[src + 1] - out_offsets_[src];
+			}
+
+			[[nodiscard]] auto in_degree(std::size_t dst) const -> std::size_t {
+				return in_offsets_[dst + 1] - in_offsets_[dst];
+			}
+
+		private:
+			std::vector<N const*> nodes_;
+			std::vector<std::size_t> out_offsets_;
+			std::vector<std::size_t> out_;
+			std::vector<std::size_t> in_offsets_;
+			std::vector<std::size_t> in_;
+
+			// A counting sort of the outgoing edges by dst. Sources are visited in ascending order,
+			// so every incoming list comes out sorted too.
+			auto index_incoming() -> void {
+				in_offsets_.assign(nodes_.size() + 1, 0);
+				for (auto dst : out_) {
+					++in_offsets_[dst + 1];
+				}
+				for (auto i = std::size_t{1}; i < in_offsets_.size(); ++i) {
+					in_offsets_[i] += in_offsets_[i - 1];
+				}
+				in_.resize(out_.size());
+				auto next = std::vector<std::size_t>(in_offsets_.begin(), in_offsets_.end() - 1);
+				for (auto src = std::size_t{0}; src < nodes_.size(); ++src) {
+					for_each_successor(src, [&](std::size_t dst) { in_[next[dst]++] = src; });
+				}
+			}
+		};
+
+		// One bit per node, packed into 64-bit words.
+		class dense_bitset {
+		public:
+			explicit dense_bitset(std::size_t size)
+			: words_((size + 63) / 64, 0) {}
+
+			[[nodiscard]] auto test(std::size_t i) const -> bool {
+				return (words_[i / 64] >> (i % 64)) & 1;
+			}
+
+			// Sets bit i, and returns whether it was clear before.
+			auto insert(std::size_t i) -> bool {
+				auto const mask = std::uint64_t{1} << (i % 64);
+				auto& word = words_[i / 64];
+				auto const inserted = (word & mask) == 0;
+				word |= mask;
+				return inserted;
+			}
+
+			auto erase(std::size_t i) -> void {
+				words_[i / 64] &= ~(std::uint64_t{1} << (i % 64));
+			}
+
+		private:
+			std::vector<std::uint64_t> words_;
+		};
+
+		// As dense_bitset, but safe to insert into from several threads at once: exactly one of
+		// any concurrent inserts of the same bit sees it as new.
+		class concurrent_bitset {
+		public:
+			explicit concurrent_bitset(std::size_t size)
+			: words_((size + 63) / 64) {}
+
+			[[nodiscard]] auto test(std::size_t i) const -> bool {
+				return (words_[i / 64].load(std::memory_order_relaxed) >> (i % 64)) & 1;
+			}
+
+			auto insert(std::size_t i) -> bool {
+				auto const mask = std::uint64_t{1} << (i % 64);
+				auto& word = words_[i / 64];
+				// A plain load first keeps the common already-visited case off the cache line's
+				// exclusive state.
+				if (word.load(std::memory_order_relaxed) & mask) {
+					return false;
+				}
+				return (word.fetch_or(mask, std::memory_order_relaxed) & mask) == 0;
+			}
+
+		private:
+			std::vector<std::atomic<std::uint64_t>> words_;
+		};
+
+		template<typename N>
+		auto to_nodes(traversal_index<N> const& index, std::vector<std::size_t> const& indices)
+		   -> std::vector<N> {
+			auto result = std::vector<N>();
+			result.reserve(indices.size());
+			for (auto i : indices) {
+				result.push_back(index.node(i));
+			}
+			return result;
+		}
+
+		// What a cached traversal depends on: every node it reached, which is every node it returns.
+		inline constexpr auto reached_nodes = [](auto const& nodes, auto const& note) {
+			for (auto const& node : nodes) {
+				note(node);
+			}
+		};
+
+		// Groups every node under the label of its component, where labels[i] is the smallest
+		// index in i's component. Components come out ordered by their smallest node, and each
+		// lists its nodes in ascending order.
+		template<typename N>
+		auto group_components(traversal_index<N> const& index, std::vector<std::size_t> const& labels)
+		   -> std::vector<std::vector<N>> {
+			auto result = std::vector<std::vector<N>>();
+			auto slot = std::vector<std::size_t>(index.size());
+			for (auto i = std::size_t{0}; i < index.size(); ++i) {
+				if (labels[i] == i) {
+					slot[i] = result.size();
+					result.emplace_back();
+				}
+				result[slot[labels[i]]].push_back(index.node(i));
+			}
+			return result;
+		}
+
+		template<typename N, typename K>
+		auto find_source(traversal_index<N> const& index, K const& src, char const* algorithm)
+		   -> std::size_t {
+			auto const source = index.find(src);
+			if (source == index.npos) {
+				throw std::runtime_error(std::string("Cannot call gdwg::") + algorithm
+				                         + " if src doesn't exist in the graph");
+			}
+			return source;
+		}
+
+		// A lock-free union-find over node indices. Roots are only ever linked under a smaller
+		// root, so a set's root is always its smallest index, whatever order the unions ran in.
+		class concurrent_union_find {
+		public:
+			explicit concurrent_union_find(std::size_t size)
+			: parent_(size) {
+				for (auto i = std::size_t{0}; i < size; ++i) {
+					parent_[i].store(i, std::memory_order_relaxed);
+				}
+			}
+
+			auto find(std::size_t i) -> std::size_t {
+				auto parent = parent_[i].load(std::memory_order_relaxed);
+				while (parent != i) {
+					// Path halving: point i at its grandparent. Losing the race is harmless, as
+					// every pointer only ever moves closer to the root.
+					auto const grandparent = parent_[parent].load(std::memory_order_relaxed);
+					parent_[i].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+					i = parent;
+					parent = parent_[i].load(std::memory_order_relaxed);
+				}
+				return i;
+			}
+
+			auto unite(std::size_t a, std::size_t b) -> void {
+				while (true) {
+					a = find(a);
+					b = find(b);
+					if (a == b) {
+						return;
+					}
+					if (a < b) {
+						std::swap(a, b);
+					}
+					// Fails if a stopped being a root in the meantime, in which case start over.
+					auto expected = a;
+					if (parent_[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) {
+						return;
+					}
+				}
+			}
+
+		private:
+			std::vector<std::atomic<std::size_t>> parent_;
+		};
+	} // namespace detail
+
+	// ======================================
+	//              Traversals
+	// ======================================
+	// On a graph with a query cache, the traversals from a single source are cached; see
+	// graph::enable_query_cache.
+
+	// Breadth-first search from `src`. Returns every node reachable from `src`, `src` first, in the
+	// order they were visited; the successors of a node are visited in ascending order.
+	template<typename N, typename E, typename K = N>
+	requires node_key<K, N>
+	[[nodiscard]] auto bfs(graph<N, E> const& g, K const& src) -> std::vector<N> {
+		return detail::cached(g, cached_query::bfs, src, detail::reached_nodes, [&] {
+			auto const index = detail::traversal_index<N>(g);
+			auto const source = detail::find_source(index, src, "bfs");
+			auto visited = detail::dense_bitset(index.size());
+			// The visit order doubles as the queue.
+			auto order = std::vector<std::size_t>{source};
+			visited.insert(source);
+			for (auto head = std::size_t{0}; head < order.size(); ++head) {
+				index.for_each_successor(order[head], [&](std::size_t dst) {
+					if (visited.insert(dst)) {
+						order.push_back(dst);
+					}
+				});
+			}
+			return detail::to_nodes(index, order);
+		});
+	}
+
+	// Breadth-first search from `src`, with the edges of each level followed by all hardware
+	// threads. Reaches the same nodes as bfs, level by level, but orders each level by value
+	// rather than by discovery, so the result doesn't depend on the number of threads.
+	template<typename N, typename E, typename K = N>
+	requires node_key<K, N>
+	[[nodiscard]] auto parallel_bfs(graph<N, E> const& g, K const& src) -> std::vector<N> {
+		return detail::cached(g, cached_query::parallel_bfs, src, detail::reached_nodes, [&] {
+			auto const index = detail::traversal_index<N>(g);
+			auto const source = detail::find_source(index, src, "parallel_bfs");
+			auto const threads = detail::hardware_threads();
+			auto visited = detail::concurrent_bitset(index.size());
+			auto discovered = std::vector<std::vector<std::size_t>>(threads);
+			auto order = std::vector<std::size_t>{source};
+			visited.insert(source);
+			for (auto level = std::size_t{0}; level < order.size();) {
+				auto const level_end = order.size();
+				auto const chunks = level_end - level < detail::parallel_threshold ? 1 : threads;
+				auto expand = [&](std::size_t first, std::size_t last, std::size_t chunk) {
+					for (auto i = level + first; i != level + last; ++i) {
+						index.for_each_successor(order[i], [&](std::size_t dst) {
+							if (visited.insert(dst)) {
+								discovered[chunk].push_back(dst);
+							}
+						});
+					}
+				};
+				detail::for_each_chunk(level_end - level, chunks, expand);
+				for (auto& found : discovered) {
+					order.insert(order.end(), found.begin(), found.end());
+					found.clear();
+				}
+				std::sort(order.begin() + static_cast<std::ptrdiff_t>(level_end), order.end());
+				level = level_end;
+			}
+			return detail::to_nodes(index, order);
+		});
+	}
+
+	// Depth-first search from `src`. Returns every node reachable from `src` in preorder, taking
+	// successors in ascending order, exactly as the recursive search would but without
+	// recursion, so deep graphs can't overflow the stack.
+	template<typename N, typename E, typename K = N>
+	requires node_key<K, N>
+	[[nodiscard]] auto dfs(graph<N, E> const& g, K const& src) -> std::vector<N> {
+		return detail::cached(g, cached_query::dfs, src, detail::reached_nodes, [&] {
+			auto const index = detail::traversal_index<N>(g);
+			auto const source = detail::find_source(index, src, "dfs");
+			auto visited = detail::dense_bitset(index.size());
+			auto order = std::vector<std::size_t>{source};
+			visited.insert(source);
+			// Each frame is a node on the current path and how many of its successors it has tried.
+			auto path = std::vector<std::pair<std::size_t, std::size_t>>{{source, 0}};
+			while (not path.empty()) {
+				auto& [node, tried] = path.back();
+				if (tried == index.out_degree(node)) {
+					path.pop_back();
+					continue;
+				}
+				auto const next = index.successor(node, tried++);
+				if (visited.insert(next)) {
+					order.push_back(next);
+					path.emplace_back(next, 0);
+				}
+			}
+			return detail::to_nodes(index, order);
+		});
+	}
+
+	// ======================================
+	//              Components
+	// ======================================
+
+	// The weakly connected components: the sets of nodes connected when edge direction is
+	// ignored. Components are ordered by their smallest node, and each is in ascending order.
+	template<typename N, typename E>
+	[[nodiscard]] auto weakly_connected_components(graph<N, E> const& g)
+	   -> std::vector<std::vector<N>> {
+		auto const index = detail::traversal_index<N>(g, true);
+		auto visited = detail::dense_bitset(index.size());
+		auto labels = std::vector<std::size_t>(index.size());
+		auto queue = std::vector<std::size_t>();
+		// Roots are taken in ascending order, so each is the smallest node of its component.
+		for (auto root = std::size_t{0}; root < index.size(); ++root) {
+			if (not visited.insert(root)) {
+				continue;
+			}
+			queue.assign(1, root);
+			auto visit = [&](std::size_t next) {
+				if (visited.insert(next)) {
+					queue.push_back(next);
+				}
+			};
+			for (auto head = std::size_t{0}; head < queue.size(); ++head) {
+				labels[queue[head]] = root;
+				index.for_each_successor(queue[head], visit);
+				index.for_each_predecessor(queue[head], visit);
+			}
+		}
+		return detail::group_components(index, labels);
+	}
+
+	// As weakly_connected_components, but the edges are merged into components by all hardware
+	// threads through a lock-free union-find. The result is identical.
+	template<typename N, typename E>
+	[[nodiscard]] auto parallel_weakly_connected_components(graph<N, E> const& g)
+	   -> std::vector<std::vector<N>> {
+		auto const index = detail::traversal_index<N>(g);
+		auto sets = detail::concurrent_union_find(index.size());
+		auto const chunks =
+		   index.edge_count() < detail::parallel_threshold ? 1 : detail::hardware_threads();
+		detail::for_each_chunk(index.size(),
+		                       chunks,
+		                       [&](std::size_t first, std::size_t last, std::size_t) {
+			                       for (auto src = first; src != last; ++src) {
+				                       index.for_each_successor(
+				                          src,
+				                          [&](std::size_t dst) { sets.unite(src, dst); });
+			                       }
+		                       });
+		auto labels = std::vector<std::size_t>(index.size());
+		for (auto i = std::size_t{0}; i < index.size(); ++i) {
+			labels[i] = sets.find(i);
+		}
+		return detail::group_components(index, labels);
+	}
+
+	// The strongly connected components: the maximal sets of nodes that can all reach each
+	// other. Found with an iterative version of Tarjan's algorithm, so components come out in
+	// reverse topological order of the graph they condense to: no component has an edge to a
+	// later one. Each component is in ascending order.
+	template<typename N, typename E>
+	[[nodiscard]] auto strongly_connected_components(graph<N, E> const& g)
+	   -> std::vector<std::vector<N>> {
+		constexpr auto unvisited = detail::traversal_index<N>::npos;
+		auto const index = detail::traversal_index<N>(g);
+		auto order = std::vector<std::size_t>(index.size(), unvisited);
+		auto low = std::vector<std::size_t>(index.size());
+		auto on_stack = detail::dense_bitset(index.size());
+		auto stack = std::vector<std::size_t>();
+		auto path = std::vector<std::pair<std::size_t, std::size_t>>();
+		auto result = std::vector<std::vector<N>>();
+		auto next_order = std::size_t{0};
+		auto discover = [&](std::size_t node) {
+			order[node] = low[node] = next_order++;
+			stack.push_back(node);
+			on_stack.insert(node);
+			path.emplace_back(node, 0);
+		};
+		for (auto root = std::size_t{0}; root < index.size(); ++root) {
+			if (order[root] != unvisited) {
+				continue;
+			}
+			discover(root);
+			while (not path.empty()) {
+				auto& [node, tried] = path.back();
+				if (tried < index.out_degree(node)) {
+					auto const next = index.successor(node, tried++);
+					if (order[next] == unvisited) {
+						discover(next);
+					}
+					else if (on_stack.test(next)) {
+						low[node] = std::min(low[node], order[next]);
+					}
+					continue;
+				}
+				auto const finished = node;
+				path.pop_back();
+				if (not path.empty()) {
+					auto const parent = path.back().first;
+					low[parent] = std::min(low[parent], low[finished]);
+				}
+				if (low[finished] != order[finished]) {
+					continue;
+				}
+				// finished is the first node of its component to be discovered, so the component
+				// is everything above it on the stack.
+				auto const first = std::find(stack.rbegin(), stack.rend(), finished).base() - 1;
+				auto members = std::vector<std::size_t>(first, stack.end());
+				stack.erase(first, stack.end());
+				std::sort(members.begin(), members.end());
+				for (auto member : members) {
+					on_stack.erase(member);
+				}
+				result.push_back(detail::to_nodes(index, members));
+			}
+		}
+		return result;
+	}
+
+	// ======================================
+	//              Ordering
+	// ======================================
+
+	// A topological order of the nodes: every edge leads from an earlier node to a later one.
+	// Kahn's algorithm with a FIFO queue: the nodes with no incoming edges come first, in ascending
+	// order, and every other node follows in the order its last incoming edge is removed. That is
+	// deterministic, but not the smallest order overall. Throws if the graph has a cycle, a
+	// self-loop included.
+	template<typename N, typename E>
+	[[nodiscard]] auto topological_sort(graph<N, E> const& g) -> std::vector<N> {
+		auto const index = detail::traversal_index<N>(g, true);
+		auto remaining = std::vector<std::size_t>(index.size());
+		auto order = std::vector<std::size_t>();
+		order.reserve(index.size());
+		for (auto i = std::size_t{0}; i < index.size(); ++i) {
+			remaining[i] = index.in_degree(i);
+			if (remaining[i] == 0) {
+				order.push_back(i);
+			}
+		}
+		// As in bfs, the order doubles as the queue.
+		for (auto head = std::size_t{0}; head < order.size(); ++head) {
+			index.for_each_successor(order[head], [&](std::size_t dst) {
+				if (--remaining[dst] == 0) {
+					order.push_back(dst);
+				}
+			});
+		}
+		if (order.size() != index.size()) {
+			throw std::runtime_error("Cannot call gdwg::topological_sort on a graph with a cycle");
+		}
+		return detail::to_nodes(index, order);
+	}
+} // namespace gdwg
+
+#endif // GDWG_GRAPH_ALGORITHMS_HPP
@@ -0,0 +1,588 @@
+#ifndef GDWG_GRAPH_BINARY_HPP
+#define GDWG_GRAPH_BINARY_HPP
+
+#include "gdwg/graph.hpp"
+#include "gdwg/mapped_file.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iterator>
+#include <new>
+#include <ostream>
+#include <range/v3/utility.hpp>
+#include <range/v3/view/transform.hpp>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// A versioned binary format for gdwg::graph, written by save_binary and read in place through
+// mapped_graph. All integers are native-endian std::uint64_t, and every section starts on a
+// `binary_alignment` boundary so it can be used straight out of the mapping:
+//
+//   header          binary_header
+//   nodes           column of N, in node order
+//   pair offsets    uint64[node_count + 1]: the (src, dst) pairs of node i are
+//                   [pair_offsets[i], pair_offsets[i + 1])
+//   pair dsts       uint64[pair_count]: node index of each pair's destination
+//   weight offsets  uint64[pair_count + 1]: the weights of pair p are
+//                   [weight_offsets[p], weight_offsets[p + 1])
+//   weights         column of E, sorted within each pair
+//
+// A column of a trivially copyable T is a raw block of T. A column of std::string is a string
+// pool: uint64[count + 1] character offsets followed by the characters themselves.
+
+namespace gdwg {
+	// Types save_binary can write and mapped_graph can read back in place.
+	template<typename T>
+	concept binary_serializable = std::is_trivially_copyable_v<T> or std::same_as<T, std::string>;
+
+	namespace detail {
+		inline constexpr auto binary_magic =
+		   std::array<char, 8>{'G', 'D', 'W', 'G', 'B', 'I', 'N', '\0'};
+		inline constexpr auto binary_version = std::uint32_t{1};
+		// Read back as a different value on a machine of the other byte order.
+		inline constexpr auto binary_byte_order = std::uint32_t{0x01020304};
+		inline constexpr auto binary_alignment = std::size_t{16};
+
+		struct binary_header {
+			std::array<char, 8> magic;
+			std::uint32_t version;
+			std::uint32_t byte_order;
+			// sizeof(T) for a raw column, 0 for a string pool.
+			std::uint32_t node_size;
+			std::uint32_t weight_size;
+			std::uint64_t node_count;
+			std::uint64_t pair_count;
+			std::uint64_t edge_count;
+		};
+
+		template<typename T>
+		inline constexpr bool pooled = std::same_as<T, std::string>;
+
+		template<typename T>
+		inline constexpr auto column_size = pooled<T> ? std::uint32_t{0} : std::uint32_t{sizeof(T)};
+
+		// Counts what it writes, so sections can be padded on a stream that can't seek.
+		class binary_writer {
+		public:
+			explicit binary_writer(std::ostream& os) noexcept
+			: os_(&os) {}
+
+			template<typename T>
+			auto write(T const& value) -> void {
+				write_bytes(reinterpret_cast<char const*>(&value), sizeof(T));
+			}
+
+			auto write_bytes(char const* data, std::size_t size) -> void {
+				os_->write(data, static_cast<std::streamsize>(size));
+				written_ += size;
+			}
+
+			auto pad() -> void {
+				while (written_ % binary_alignment != 0) {
+					os_->put('\0');
+					++written_;
+				}
+			}
+
+		private:
+			std::ostream* os_;
+			std::size_t written_ = 0;
+		};
+
+		// Writes one column from a range that is walked once, or twice for a string pool.
+		template<typename T, typename R>
+		auto write_column(binary_writer& out, R const& values) -> void {
+			if constexpr (pooled<T>) {
+				auto offset = std::uint64_t{0};
+				out.write(offset);
+				for (auto const& value : values) {
+					offset += value.size();
+					out.write(offset);
+				}
+				out.pad();
+				for (auto const& value : values) {
+					out.write_bytes(value.data(), value.size());
+				}
+			}
+			else {
+				for (auto const& value : values) {
+					out.write(value);
+				}
+			}
+			out.pad();
+		}
+
+		// Hands out consecutive aligned sections of a mapping, refusing to run past its end.
+		class binary_reader {
+		public:
+			binary_reader(char const* data, std::size_t size) noexcept
+			: data_(data)
+			, size_(size) {}
+
+			template<typename T>
+			auto take(std::size_t count) -> T const* {
+				auto const bytes = count * sizeof(T);
+				if (bytes / sizeof(T) != count or bytes > size_ - offset_) {
+					throw std::runtime_error("Cannot call gdwg::mapped_graph<N, E>::mapped_graph on a "
+					                         "truncated file");
+				}
+				auto const* result = std::launder(reinterpret_cast<T const*>(data_ + offset_));
+				offset_ += bytes;
+				offset_ = std::min(size_,
+				                   (offset_ + binary_alignment - 1) / binary_alignment * binary_alignment);
+				return result;
+			}
+
+		private:
+			char const* data_;
+			std::size_t size_;
+			std::size_t offset_ = 0;
+		};
+
+		// Whether offsets[0..count] run from 0 to `total` without going back, so every range they
+		// delimit lies inside the section they index. A range may be empty only if `allow_empty`.
+		inline auto valid_offsets(std::uint64_t const* offsets,
+		                          std::size_t count,
+		                          std::uint64_t total,
+		                          bool allow_empty) noexcept -> bool {
+			if (offsets[0] != 0 or offsets[count] != total) {
+				return false;
+			}
+			for (auto i = std::size_t{0}; i < count; ++i) {
+				if (offsets[i + 1] < offsets[i] or (!allow_empty and offsets[i + 1] == offsets[i])) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		// A column inside a mapping. Elements of a string pool are std::string_views into it.
+		template<typename T>
+		class column_view {
+		public:
+			using reference = std::conditional_t<pooled<T>, std::string_view, T const&>;
+
+			column_view() = default;
+
+			column_view(binary_reader& in, std::size_t count) {
+				if constexpr (pooled<T>) {
+					offsets_ = in.take<std::uint64_t>(count + 1);
+					chars_ = in.take<char>(offsets_[count]);
+					if (!valid_offsets(offsets_, count, offsets_[count], true)) {
+						throw std::runtime_error("Cannot call gdwg::mapped_graph<N, E>::mapped_graph on a "
+						                         "corrupt file");
+					}
+				}
+				else {
+					values_ = in.take<T>(count);
+				}
+			}
+
+			auto operator[](std::size_t i) const -> reference {
+				if constexpr (pooled<T>) {
+					return std::string_view(chars_ + offsets_[i], offsets_[i + 1] - offsets_[i]);
+				}
+				else {
+					return values_[i];
+				}
+			}
+
+		private:
+			T const* values_ = nullptr;
+			std::uint64_t const* offsets_ = nullptr;
+			char const* chars_ = nullptr;
+		};
+	} // namespace detail
+
+	// Writes `g` in the binary format, streaming every section straight from the graph. Beyond the
+	// graph itself, only one pointer per node is held in memory.
+	template<binary_serializable N, binary_serializable E>
+	auto save_binary(graph<N, E> const& g, std::ostream& os) -> void {
+		auto nodes = std::vector<N const*>();
+		for (auto const& node : g.nodes_view()) {
+			nodes.push_back(&node);
+		}
+		auto const edges = g.edges_view();
+		// Calls f(src, dst, index of the first weight) for each (src, dst) pair. Edges arrive ordered
+		// by (src, dst, weight) and refer to the graph's own nodes, so a new pair starts wherever
+		// either address changes.
+		auto for_each_pair = [&edges](auto&& f) {
+			auto const* src = static_cast<N const*>(nullptr);
+			auto const* dst = static_cast<N const*>(nullptr);
+			auto index = std::uint64_t{0};
+			for (auto const& [from, to, weight] : edges) {
+				if (&from != src or &to != dst) {
+					src = &from;
+					dst = &to;
+					f(from, to, index);
+				}
+				++index;
+			}
+		};
+
+		auto header = detail::binary_header{
+		   .magic = detail::binary_magic,
+		   .version = detail::binary_version,
+		   .byte_order = detail::binary_byte_order,
+		   .node_size = detail::column_size<N>,
+		   .weight_size = detail::column_size<E>,
+		   .node_count = nodes.size(),
+		   .pair_count = 0,
+		   .edge_count = static_cast<std::uint64_t>(ranges::distance(edges)),
+		};
+		for_each_pair([&header](N const&, N const&, std::uint64_t) { ++header.pair_count; });
+
+		auto out = detail::binary_writer(os);
+		out.write(header);
+		out.pad();
+		detail::write_column<N>(out, g.nodes_view());
+
+		// The offset of every node up to and including a pair's source is the number of pairs
+		// before it.
+		auto pairs = std::uint64_t{0};
+		auto next_node = std::size_t{0};
+		for_each_pair([&](N const& src, N const&, std::uint64_t) {
+			while (next_node == 0 or nodes[next_node - 1] != &src) {
+				out.write(pairs);
+				++next_node;
+			}
+			++pairs;
+		});
+		for (; next_node <= nodes.size(); ++next_node) {
+			out.write(pairs);
+		}
+		out.pad();
+
+		for_each_pair([&](N const&, N const& dst, std::uint64_t) {
+			auto result =
+			   std::lower_bound(nodes.begin(), nodes.end(), dst, [](N const* a, N const& b) {
+				   return *a < b;
+			   });
+			out.write(static_cast<std::uint64_t>(result - nodes.begin()));
+		});
+		out.pad();
+
+		for_each_pair([&out](N const&, N const&, std::uint64_t first_weight) {
+			out.write(first_weight);
+		});
+		out.write(header.edge_count);
+		out.pad();
+
+		auto const weights = edges | ranges::views::transform([](auto const& edge) -> E const& {
+			                     return std::get<2>(edge);
+		                     });
+		detail::write_column<E>(out, weights);
+	}
+
+	// A read-only graph served straight out of a memory-mapped file written by save_binary. Opening
+	// one checks every offset in the file against the mapping, but nodes and weights are used in
+	// place, so there is no parsing and no per-element allocation. Nodes and weights held in a
+	// string pool are std::string_views.
+	template<binary_serializable N, binary_serializable E>
+	requires concepts::totally_ordered<N> and concepts::totally_ordered<E>
+	class mapped_graph {
+	public:
+		class iterator;
+		using node_reference = typename detail::column_view<N>::reference;
+		using weight_reference = typename detail::column_view<E>::reference;
+
+		// ======================================
+		//              Constructors
+		// ======================================
+		explicit mapped_graph(std::filesystem::path const& path)
+		: file_(path, "gdwg::mapped_graph<N, E>::mapped_graph") {
+			if (file_.size() == 0) {
+				throw std::runtime_error("Cannot call gdwg::mapped_graph<N, E>::mapped_graph on a file "
+				                         "that isn't a gdwg::graph binary");
+			}
+			auto in = detail::binary_reader(file_.data(), file_.size());
+			auto const& header = *in.take<detail::binary_header>(1);
+			if (header.magic != detail::binary_magic or header.version != detail::binary_version
+			    or header.byte_order != detail::binary_byte_order)
+			{
+				throw std::runtime_error("Cannot call gdwg::mapped_graph<N, E>::mapped_graph on a file "
+				                         "that isn't a gdwg::graph binary");
+			}
+			if (header.node_size != detail::column_size<N>
+			    or header.weight_size != detail::column_size<E>) {
+				throw std::runtime_error("Cannot call gdwg::mapped_graph<N, E>::mapped_graph on a file "
+				                         "written for different node or weight types");
+			}
+			// Every node, pair and edge takes at least a byte, which also keeps count + 1 from
+			// overflowing below.
+			if (header.node_count > file_.size() or header.pair_count > file_.size()
+			    or header.edge_count > file_.size())
+			{
+				throw std::runtime_error("Cannot call gdwg::mapped_graph<N, E>::mapped_graph on a "
+				                         "truncated file");
+			}
+			node_count_ = header.node_count;
+			pair_count_ = header.pair_count;
+			edge_count_ = header.edge_count;
+			nodes_ = detail::column_view<N>(in, node_count_);
+			pair_offsets_ = in.take<std::uint64_t>(node_count_ + 1);
+			pair_dsts_ = in.take<std::uint64_t>(pair_count_);
+			weight_offsets_ = in.take<std::uint64_t>(pair_count_ + 1);
+			weights_ = detail::column_view<E>(in, edge_count_);
+			auto const dst_in_range = [this](std::uint64_t dst) { return dst < node_count_; };
+			if (!detail::valid_offsets(pair_offsets_, node_count_, pair_count_, true)
+			    or !detail::valid_offsets(weight_offsets_, pair_count_, edge_count_, false)
+			    or !std::all_of(pair_dsts_, pair_dsts_ + pair_count_, dst_in_range))
+			{
+				throw std::runtime_error("Cannot call gdwg::mapped_graph<N, E>::mapped_graph on a "
+				                         "corrupt file");
+			}
+		}
+
+		// Rebuilds a mutable graph holding the same nodes and edges.
+		[[nodiscard]] auto thaw() const -> graph<N, E> {
+			auto values = ranges::subrange<iterator>(begin(), end())
+			              | ranges::views::transform([](auto const& edge) {
+				                auto const& [from, to, weight] = edge;
+				                return typename graph<N, E>::value_type{N(from), N(to), E(weight)};
+			                });
+			auto result = graph<N, E>(sorted_unique, values.begin(), values.end());
+			for (auto i = std::size_t{0}; i < node_count_; ++i) {
+				result.insert_node(N(nodes_[i]));
+			}
+			return result;
+		}
+
+		// ======================================
+		//              Accessors
+		// ======================================
+		template<typename K = N>
+		requires node_key<K, N>
+		[[nodiscard]] auto is_node(K const& value) const -> bool {
+			return find_index(value) != npos;
+		}
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return node_count_ == 0;
+		}
+
+		template<typename K1 = N, typename K2 = N>
+		requires node_key<K1, N> and node_key<K2, N>
+		[[nodiscard]] auto is_connected(K1 const& src, K2 const& dst) const -> bool {
+			auto src_index = find_index(src);
+			auto dst_index = find_index(dst);
+			if (src_index == npos || dst_index == npos) {
+				throw std::runtime_error("Cannot call gdwg::mapped_graph<N, E>::is_connected if src or "
+				                         "dst node don't exist in the graph");
+			}
+			return find_pair(src_index, dst_index) != npos;
+		}
+
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			auto result = std::vector<N>();
+			result.reserve(node_count_);
+			for (auto i = std::size_t{0}; i < node_count_; ++i) {
+				result.emplace_back(nodes_[i]);
+			}
+			return result;
+		}
+
+		template<typename K1 = N, typename K2 = N>
+		requires node_key<K1, N> and node_key<K2, N>
+		[[nodiscard]] auto weights(K1 const& from, K2 const& to) const -> std::vector<E> {
+			auto src_index = find_index(from);
+			auto dst_index = find_index(to);
+			if (src_index == npos || dst_index == npos) {
+				throw std::runtime_error("Cannot call gdwg::mapped_graph<N, E>::weights if src or dst "
+				                         "node don't exist in the graph");
+			}
+			auto result = std::vector<E>();
+			if (auto pair = find_pair(src_index, dst_index); pair != npos) {
+				for (auto i = weight_offsets_[pair]; i != weight_offsets_[pair + 1]; ++i) {
+					result.emplace_back(weights_[i]);
+				}
+			}
+			return result;
+		}
+
+		template<typename K1 = N, typename K2 = N>
+		requires node_key<K1, N> and node_key<K2, N>
+		[[nodiscard]] auto find(K1 const& src, K2 const& dst, E const& weight) const -> iterator {
+			auto src_index = find_index(src);
+			auto dst_index = find_index(dst);
+			if (src_index == npos || dst_index == npos) {
+				return end();
+			}
+			auto pair = find_pair(src_index, dst_index);
+			if (pair == npos) {
+				return end();
+			}
+			auto first = weight_offsets_[pair];
+			auto last = weight_offsets_[pair + 1];
+			while (first != last) {
+				auto middle = first + (last - first) / 2;
+				if (weights_[middle] < weight) {
+					first = middle + 1;
+				}
+				else {
+					last = middle;
+				}
+			}
+			if (first == weight_offsets_[pair + 1] || weights_[first] != weight) {
+				return end();
+			}
+			return iterator(*this, src_index, pair, first);
+		}
+
+		template<typename K = N>
+		requires node_key<K, N>
+		[[nodiscard]] auto connections(K const& src) const -> std::vector<N> {
+			auto src_index = find_index(src);
+			if (src_index == npos) {
+				throw std::runtime_error("Cannot call gdwg::mapped_graph<N, E>::connections if src "
+				                         "doesn't exist in the graph");
+			}
+			auto result = std::vector<N>();
+			for (auto i = pair_offsets_[src_index]; i != pair_offsets_[src_index + 1]; ++i) {
+				result.emplace_back(nodes_[pair_dsts_[i]]);
+			}
+			return result;
+		}
+
+		// ======================================
+		//              Range Access
+		// ======================================
+		[[nodiscard]] auto begin() const -> iterator {
+			return iterator(*this, source_of(0, 0), 0, 0);
+		}
+
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator(*this, node_count_, pair_count_, edge_count_);
+		}
+
+		// ======================================
+		//              Iterators
+		// ======================================
+		class iterator {
+		public:
+			using value_type = ranges::common_tuple<N, N, E>;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			// Iterator constructor
+			iterator() = default;
+
+			// Iterator source
+			auto operator*() const
+			   -> ranges::common_tuple<node_reference, node_reference, weight_reference> {
+				return ranges::common_tuple<node_reference, node_reference, weight_reference>{
+				   pointee_->nodes_[src_],
+				   pointee_->nodes_[pointee_->pair_dsts_[pair_]],
+				   pointee_->weights_[edge_]};
+			}
+
+			// Iterator traversal
+			auto operator++() -> iterator& {
+				if (++edge_ == pointee_->weight_offsets_[pair_ + 1]) {
+					++pair_;
+					src_ = pointee_->source_of(src_, pair_);
+				}
+				return *this;
+			}
+			auto operator++(int) -> iterator {
+				auto temp = *this;
+				++*this;
+				return temp;
+			}
+			auto operator--() -> iterator& {
+				if (edge_-- == pointee_->weight_offsets_[pair_]) {
+					--pair_;
+					while (pointee_->pair_offsets_[src_] > pair_) {
+						--src_;
+					}
+				}
+				return *this;
+			}
+			auto operator--(int) -> iterator {
+				auto temp = *this;
+				--*this;
+				return temp;
+			}
+
+			// Iterator comparison
+			auto operator==(iterator const& other) const -> bool {
+				return edge_ == other.edge_;
+			}
+
+		private:
+			mapped_graph const* pointee_ = nullptr;
+			std::size_t src_ = 0;
+			std::size_t pair_ = 0;
+			std::size_t edge_ = 0;
+			friend class mapped_graph;
+			explicit iterator(mapped_graph const& pointee,
+			                  std::size_t src,
+			                  std::size_t pair,
+			                  std::size_t edge) noexcept
+			: pointee_(&pointee)
+			, src_(src)
+			, pair_(pair)
+			, edge_(edge) {}
+		};
+
+	private:
+		static constexpr auto npos = static_cast<std::size_t>(-1);
+
+		detail::mapped_file file_;
+		std::size_t node_count_ = 0;
+		std::size_t pair_count_ = 0;
+		std::size_t edge_count_ = 0;
+		detail::column_view<N> nodes_;
+		std::uint64_t const* pair_offsets_ = nullptr;
+		std::uint64_t const* pair_dsts_ = nullptr;
+		std::uint64_t const* weight_offsets_ = nullptr;
+		detail::column_view<E> weights_;
+
+		template<typename K>
+		auto find_index(K const& node) const -> std::size_t {
+			auto first = std::size_t{0};
+			auto last = node_count_;
+			while (first != last) {
+				auto middle = first + (last - first) / 2;
+				if (nodes_[middle] < node) {
+					first = middle + 1;
+				}
+				else {
+					last = middle;
+				}
+			}
+			if (first == node_count_ || nodes_[first] != node) {
+				return npos;
+			}
+			return first;
+		}
+
+		auto find_pair(std::size_t src, std::size_t dst) const -> std::size_t {
+			auto const* first = pair_dsts_ + pair_offsets_[src];
+			auto const* last = pair_dsts_ + pair_offsets_[src + 1];
+			auto result = std::lower_bound(first, last, std::uint64_t{dst});
+			if (result == last || *result != dst) {
+				return npos;
+			}
+			return static_cast<std::size_t>(result - pair_dsts_);
+		}
+
+		// The source owning `pair`, searching forward from `src` past nodes with no outgoing edges.
+		auto source_of(std::size_t src, std::size_t pair) const -> std::size_t {
+			while (src < node_count_ && pair_offsets_[src + 1] <= pair) {
+				++src;
+			}
+			return src;
+		}
+	};
+} // namespace gdwg
+
+#endif // GDWG_GRAPH_BINARY_HPP
@@ -0,0 +1,207 @@
+#ifndef GDWG_GRAPH_READER_HPP
+#define GDWG_GRAPH_READER_HPP
+
+#include "gdwg/graph.hpp"
+#include "gdwg/text_buffer.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <fmt/format.h>
+#include <functional>
+#include <istream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	namespace detail {
+		// Parses the whole of `text` as a T, as operator<< would have written it.
+		template<typename T>
+		auto parse_value(std::string_view text, T& value) -> bool {
+			if constexpr (std::same_as<T, std::string>) {
+				value.assign(text);
+				return true;
+			}
+			else if constexpr (charconv_readable<T>) {
+				auto const* last = text.data() + text.size();
+				auto [end, error] = std::from_chars(text.data(), last, value);
+				return error == std::errc() and end == last;
+			}
+			else {
+				auto in = std::istringstream(std::string(text));
+				return static_cast<bool>(in >> value) and (in >> std::ws).eof();
+			}
+		}
+	} // namespace detail
+
+	// Reads the text format written by graph's operator<< back into a graph:
+	//
+	//   src (
+	//     dst | weight
+	//   )
+	//
+	// The input is consumed in fixed-size chunks and parsed lines are handed to the graph in
+	// batches, so memory stays bounded by the chunk and batch sizes however large the dump is.
+	// Numbers go through std::from_chars, strings are taken verbatim, and any other type falls back
+	// to its operator>>. Like operator<<, the format can't represent a node containing " | " or any
+	// value containing a newline.
+	template<concepts::regular N, concepts::regular E>
+	requires concepts::totally_ordered<N> //
+	   and concepts::totally_ordered<E> //
+
+	   class graph_reader {
+	public:
+		struct progress {
+			std::size_t bytes = 0;
+			std::size_t nodes = 0;
+			std::size_t edges = 0;
+		};
+
+		explicit graph_reader(std::istream& is,
+		                      std::size_t chunk_size = std::size_t{1} << 20,
+		                      std::size_t batch_size = std::size_t{1} << 16)
+		: is_(&is)
+		, chunk_size_(std::max(chunk_size, std::size_t{1}))
+		, batch_size_(std::max(batch_size, std::size_t{1})) {}
+
+		// Called after every batch handed to the graph, and once more at the end.
+		auto on_progress(std::function<void(progress const&)> callback) -> graph_reader& {
+			on_progress_ = std::move(callback);
+			return *this;
+		}
+
+		// Adds every node and edge up to the end of the stream to `g`. Throws on malformed input,
+		// leaving `g` holding the batches read before the error.
+		auto read_into(graph<N, E>& g) -> void {
+			auto buffer = std::string();
+			while (*is_) {
+				auto const kept = buffer.size();
+				buffer.resize(kept + chunk_size_);
+				is_->read(buffer.data() + kept, static_cast<std::streamsize>(chunk_size_));
+				auto const read = static_cast<std::size_t>(is_->gcount());
+				buffer.resize(kept + read);
+				progress_.bytes += read;
+
+				auto const last_newline = buffer.rfind('\n');
+				if (last_newline == std::string::npos) {
+					continue;
+				}
+				auto lines = std::string_view(buffer).substr(0, last_newline + 1);
+				while (not lines.empty()) {
+					auto const end = lines.find('\n');
+					parse_line(lines.substr(0, end), g);
+					lines.remove_prefix(end + 1);
+				}
+				buffer.erase(0, last_newline + 1);
+			}
+			if (not buffer.empty()) {
+				parse_line(buffer, g);
+			}
+			if (in_node_) {
+				fail("the last node is missing its closing ')'");
+			}
+			flush(g);
+			report();
+		}
+
+	private:
+		std::istream* is_;
+		std::size_t chunk_size_;
+		std::size_t batch_size_;
+		std::function<void(progress const&)> on_progress_;
+		progress progress_;
+
+		std::size_t line_ = 0;
+		bool in_node_ = false;
+		N src_ = N();
+		std::vector<N> nodes_;
+		std::vector<typename graph<N, E>::value_type> edges_;
+
+		auto parse_line(std::string_view line, graph<N, E>& g) -> void {
+			++line_;
+			if (not line.empty() and line.back() == '\r') {
+				line.remove_suffix(1);
+			}
+			if (not in_node_) {
+				if (line.empty()) {
+					return;
+				}
+				if (line.size() < 2 or line.substr(line.size() - 2) != " (") {
+					fail("expected 'node ('");
+				}
+				if (not detail::parse_value(line.substr(0, line.size() - 2), src_)) {
+					fail("the node can't be parsed");
+				}
+				nodes_.push_back(src_);
+				in_node_ = true;
+			}
+			else if (line == ")") {
+				in_node_ = false;
+			}
+			else {
+				auto const separator = line.find(" | ", 2);
+				if (line.substr(0, 2) != "  " or separator == std::string_view::npos) {
+					fail("expected '  dst | weight' or ')'");
+				}
+				auto edge = typename graph<N, E>::value_type{src_, N(), E()};
+				if (not detail::parse_value(line.substr(2, separator - 2), edge.to)) {
+					fail("the destination node can't be parsed");
+				}
+				if (not detail::parse_value(line.substr(separator + 3), edge.weight)) {
+					fail("the weight can't be parsed");
+				}
+				edges_.push_back(std::move(edge));
+			}
+			if (nodes_.size() + edges_.size() >= batch_size_) {
+				flush(g);
+				report();
+			}
+		}
+
+		auto flush(graph<N, E>& g) -> void {
+			for (auto const& node : nodes_) {
+				progress_.nodes += g.insert_node(node) ? 1 : 0;
+			}
+			for (auto const& [from, to, weight] : edges_) {
+				progress_.nodes += g.insert_node(to) ? 1 : 0;
+				progress_.edges += g.insert_edge(from, to, weight) ? 1 : 0;
+			}
+			nodes_.clear();
+			edges_.clear();
+		}
+
+		auto report() const -> void {
+			if (on_progress_) {
+				on_progress_(progress_);
+			}
+		}
+
+		[[noreturn]] auto fail(std::string_view reason) const -> void {
+			throw std::runtime_error(
+			   fmt::format("Cannot read a gdwg::graph<N, E> from line {}: {}", line_, reason));
+		}
+	};
+
+	// Replaces the contents of `g` with the graph read from the rest of `is`. On malformed input,
+	// sets failbit and leaves `g` holding what was read before the error.
+	template<typename N, typename E>
+	auto operator>>(std::istream& is, graph<N, E>& g) -> std::istream& {
+		g.clear();
+		try {
+			graph_reader<N, E>(is).read_into(g);
+			is.clear(is.rdstate() & ~std::ios::failbit);
+		} catch (std::runtime_error const&) {
+			is.setstate(std::ios::failbit);
+		}
+		return is;
+	}
+} // namespace gdwg
+
+#endif // GDWG_GRAPH_READER_HPP
@@ -0,0 +1,339 @@
+#ifndef GDWG_GRAPH_STATS_HPP
+#define GDWG_GRAPH_STATS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Define GDWG_INSTRUMENTATION to 1, the same way in every translation unit, to have every graph
+// count what it does. Left undefined, the counters and probes compile away to nothing.
+#ifndef GDWG_INSTRUMENTATION
+#define GDWG_INSTRUMENTATION 0
+#endif
+
+namespace gdwg {
+	inline constexpr bool instrumentation_enabled = GDWG_INSTRUMENTATION != 0;
+
+	// The public members of graph whose calls are timed. Not timed are the destructor, the O(1)
+	// queries of the graph's configuration (empty, storage, resource, version and the has_*
+	// members), reserve, and the members that manage the instrumentation and query cache
+	// themselves. The *_view members, begin() and end() time only building the view or iterator;
+	// walking it afterwards is not part of any call.
+	enum class graph_operation {
+		insert_node,
+		insert_edge,
+		replace_node,
+		merge_replace_node,
+		merge_nodes,
+		erase_node,
+		erase_edge,
+		apply,
+		clear,
+		is_node,
+		is_connected,
+		nodes,
+		weights,
+		find,
+		connections,
+		predecessors,
+		in_degree,
+		edges_in_weight_range,
+		top_k_edges,
+		all_edges,
+		nodes_view,
+		edges_view,
+		weights_view,
+		begin,
+		end,
+		equals,
+		output,
+		write_text,
+		copy_construct,
+		copy_assign,
+		move_construct,
+		move_assign,
+	};
+	inline constexpr auto graph_operation_count =
+	   static_cast<std::size_t>(graph_operation::move_assign) + 1;
+
+	// Call latencies in power-of-two buckets: bucket 0 counts calls under 2ns, and bucket i > 0
+	// counts calls that took [2^i, 2^(i+1)) nanoseconds, with the last bucket open-ended.
+	struct latency_histogram {
+		static constexpr auto bucket_count = std::size_t{40};
+
+		std::uint64_t calls = 0;
+		std::chrono::nanoseconds total{0};
+		std::array<std::uint64_t, bucket_count> buckets{};
+
+		[[nodiscard]] static auto bucket_for(std::chrono::nanoseconds latency) noexcept
+		   -> std::size_t {
+			auto const ticks =
+			   static_cast<std::uint64_t>(std::max<std::int64_t>(latency.count(), 1));
+			return std::min<std::size_t>(bucket_count - 1, std::bit_width(ticks) - 1);
+		}
+
+		// An upper bound on the latency of the given fraction of calls, e.g. 0.99 for the 99th
+		// percentile, to within a factor of two. Zero when nothing has been recorded.
+		[[nodiscard]] auto percentile(double fraction) const noexcept -> std::chrono::nanoseconds {
+			auto const wanted = static_cast<double>(calls) * fraction;
+			auto seen = std::uint64_t{0};
+			for (auto i = std::size_t{0}; i < bucket_count; ++i) {
+				seen += buckets[i];
+				if (seen > 0 and static_cast<double>(seen) >= wanted) {
+					return std::chrono::nanoseconds(std::int64_t{2} << i);
+				}
+			}
+			return std::chrono::nanoseconds(0);
+		}
+	};
+
+	// A snapshot of a graph's counters since it was constructed or last reset. Work done inside a
+	// call is attributed to the outermost public member of the graph that was called, and only
+	// that call is timed.
+	struct graph_stats {
+		// Node comparisons made by the graph's ordered containers.
+		std::uint64_t comparisons = 0;
+		// Node lookups by value.
+		std::uint64_t lookups = 0;
+		// Source adjacencies visited by whole-graph scans, which is what erasing, replacing or
+		// querying the predecessors of a node costs without an incoming index. A high count
+		// relative to the calls is the sign of a graph that wants one.
+		std::uint64_t adjacency_scans = 0;
+		// Blocks requested from and returned to the graph's memory resource. Every tree element
+		// is one block, so these also count the insertions and erasures that rebalance a tree.
+		std::uint64_t allocations = 0;
+		std::uint64_t deallocations = 0;
+		std::uint64_t bytes_allocated = 0;
+		std::array<latency_histogram, graph_operation_count> operations{};
+
+		[[nodiscard]] auto operator[](graph_operation op) const noexcept
+		   -> latency_histogram const& {
+			return operations[static_cast<std::size_t>(op)];
+		}
+	};
+
+	namespace detail {
+		// Counters bumped on hot paths go to the calling thread first and are added to the graph
+		// once its outermost call returns, so a lookup costs an increment, not an atomic operation.
+		struct probe_tally {
+			void const* owner = nullptr;
+			std::uint64_t comparisons = 0;
+			std::uint64_t lookups = 0;
+			std::uint64_t adjacency_scans = 0;
+		};
+		inline thread_local auto tally = probe_tally();
+
+		inline auto count_comparison() noexcept -> void {
+			if constexpr (instrumentation_enabled) {
+				++tally.comparisons;
+			}
+		}
+
+		inline auto count_lookup() noexcept -> void {
+			if constexpr (instrumentation_enabled) {
+				++tally.lookups;
+			}
+		}
+
+		inline auto count_adjacency_scans(std::size_t scanned) noexcept -> void {
+			if constexpr (instrumentation_enabled) {
+				tally.adjacency_scans += scanned;
+			}
+		}
+
+		// std::less<> for node sets, counting each comparison.
+		struct counting_less {
+			using is_transparent = void;
+
+			template<typename A, typename B>
+			auto operator()(A const& a, B const& b) const -> bool {
+				count_comparison();
+				return a < b;
+			}
+		};
+
+		// The live counters of one graph. They sit behind the memory resource its containers
+		// allocate from, which therefore has to keep one address for the graph's whole life: it is
+		// held by pointer and moves with the containers. Every counter is atomic, so const members
+		// may be called from several threads at once.
+		class graph_instrumentation : public std::pmr::memory_resource {
+		public:
+			explicit graph_instrumentation(std::pmr::memory_resource* upstream) noexcept
+			: upstream_(upstream) {}
+
+			[[nodiscard]] auto upstream() const noexcept -> std::pmr::memory_resource* {
+				return upstream_;
+			}
+
+			auto set_upstream(std::pmr::memory_resource* upstream) noexcept -> void {
+				upstream_ = upstream;
+			}
+
+			auto record(graph_operation op, std::chrono::nanoseconds latency, probe_tally const& t)
+			   -> void {
+				constexpr auto relaxed = std::memory_order_relaxed;
+				comparisons_.fetch_add(t.comparisons, relaxed);
+				lookups_.fetch_add(t.lookups, relaxed);
+				adjacency_scans_.fetch_add(t.adjacency_scans, relaxed);
+				auto& histogram = operations_[static_cast<std::size_t>(op)];
+				histogram.calls.fetch_add(1, relaxed);
+				histogram.total.fetch_add(static_cast<std::uint64_t>(latency.count()), relaxed);
+				histogram.buckets[latency_histogram::bucket_for(latency)].fetch_add(1, relaxed);
+			}
+
+			[[nodiscard]] auto snapshot() const -> graph_stats {
+				constexpr auto relaxed = std::memory_order_relaxed;
+				auto result = graph_stats();
+				result.comparisons = comparisons_.load(relaxed);
+				result.lookups = lookups_.load(relaxed);
+				result.adjacency_scans = adjacency_scans_.load(relaxed);
+				result.allocations = allocations_.load(relaxed);
+				result.deallocations = deallocations_.load(relaxed);
+				result.bytes_allocated = bytes_allocated_.load(relaxed);
+				for (auto i = std::size_t{0}; i < graph_operation_count; ++i) {
+					auto const& from = operations_[i];
+					auto& to = result.operations[i];
+					to.calls = from.calls.load(relaxed);
+					to.total = std::chrono::nanoseconds(from.total.load(relaxed));
+					for (auto b = std::size_t{0}; b < latency_histogram::bucket_count; ++b) {
+						to.buckets[b] = from.buckets[b].load(relaxed);
+					}
+				}
+				return result;
+			}
+
+			auto reset() noexcept -> void {
+				constexpr auto relaxed = std::memory_order_relaxed;
+				for (auto* counter : {&comparisons_,
+				                      &lookups_,
+				                      &adjacency_scans_,
+				                      &allocations_,
+				                      &deallocations_,
+				                      &bytes_allocated_}) {
+					counter->store(0, relaxed);
+				}
+				for (auto& histogram : operations_) {
+					histogram.calls.store(0, relaxed);
+					histogram.total.store(0, relaxed);
+					for (auto& bucket : histogram.buckets) {
+						bucket.store(0, relaxed);
+					}
+				}
+			}
+
+		private:
+			struct atomic_histogram {
+				std::atomic<std::uint64_t> calls{0};
+				std::atomic<std::uint64_t> total{0};
+				std::array<std::atomic<std::uint64_t>, latency_histogram::bucket_count> buckets{};
+			};
+
+			std::pmr::memory_resource* upstream_;
+			std::atomic<std::uint64_t> comparisons_{0};
+			std::atomic<std::uint64_t> lookups_{0};
+			std::atomic<std::uint64_t> adjacency_scans_{0};
+			std::atomic<std::uint64_t> allocations_{0};
+			std::atomic<std::uint64_t> deallocations_{0};
+			std::atomic<std::uint64_t> bytes_allocated_{0};
+			std::array<atomic_histogram, graph_operation_count> operations_{};
+
+			auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override {
+				auto* result = upstream_->allocate(bytes, alignment);
+				allocations_.fetch_add(1, std::memory_order_relaxed);
+				bytes_allocated_.fetch_add(bytes, std::memory_order_relaxed);
+				return result;
+			}
+
+			auto do_deallocate(void* p, std::size_t bytes, std::size_t alignment) -> void override {
+				deallocations_.fetch_add(1, std::memory_order_relaxed);
+				upstream_->deallocate(p, bytes, alignment);
+			}
+
+			[[nodiscard]] auto do_is_equal(std::pmr::memory_resource const& other) const noexcept
+			   -> bool override {
+				return this == &other;
+			}
+		};
+
+		// Times one call of a public member and settles its tally with the graph. A call made
+		// while the same graph is already being probed on this thread is part of the outer one and
+		// isn't probed again; a call on another graph sets the outer tally aside until it returns.
+		template<bool Enabled = instrumentation_enabled>
+		class basic_probe {
+		public:
+			basic_probe(graph_instrumentation* target, graph_operation op) noexcept
+			: target_(target == nullptr or tally.owner == target ? nullptr : target)
+			, op_(op) {
+				if (target_ != nullptr) {
+					saved_ = std::exchange(tally, probe_tally{target_});
+					start_ = std::chrono::steady_clock::now();
+				}
+			}
+
+			basic_probe(basic_probe const&) = delete;
+			auto operator=(basic_probe const&) -> basic_probe& = delete;
+
+			~basic_probe() {
+				if (target_ != nullptr) {
+					auto const latency = std::chrono::steady_clock::now() - start_;
+					target_->record(op_,
+					                std::chrono::duration_cast<std::chrono::nanoseconds>(latency),
+					                tally);
+					tally = saved_;
+				}
+			}
+
+		private:
+			graph_instrumentation* target_;
+			graph_operation op_;
+			probe_tally saved_;
+			std::chrono::steady_clock::time_point start_;
+		};
+
+		// Declared maybe_unused, as with nothing to do on destruction a probe would otherwise look
+		// like an unused variable.
+		template<>
+		class [[maybe_unused]] basic_probe<false> {
+		public:
+			basic_probe(graph_instrumentation*, graph_operation) noexcept {}
+		};
+
+		using probe = basic_probe<>;
+
+		// What a graph holds to be instrumented: the counters, or with instrumentation off, an
+		// empty handle that is always null, so the same code compiles either way.
+		struct no_instrumentation {
+			[[nodiscard]] constexpr auto get() const noexcept -> graph_instrumentation* {
+				return nullptr;
+			}
+
+			constexpr auto operator->() const noexcept -> graph_instrumentation* {
+				return nullptr;
+			}
+
+			auto reset(graph_instrumentation* p) const noexcept -> void {
+				delete p;
+			}
+
+			friend constexpr auto operator==(no_instrumentation, std::nullptr_t) noexcept -> bool {
+				return true;
+			}
+		};
+		using instrumentation_handle =
+		   std::conditional_t<instrumentation_enabled,
+		                      std::unique_ptr<graph_instrumentation>,
+		                      no_instrumentation>;
+	} // namespace detail
+} // namespace gdwg
+
+#endif // GDWG_GRAPH_STATS_HPP
@@ -0,0 +1,413 @@
+#ifndef GDWG_INTERNED_GRAPH_HPP
+#define GDWG_INTERNED_GRAPH_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <range/v3/utility.hpp>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	namespace detail {
+		template<typename T>
+		concept hashable = requires(T const& value) {
+			{ std::hash<T>()(value) } -> std::convertible_to<std::size_t>;
+		};
+
+		// Value -> ID. Hashed where N can be, so a lookup costs one hash and usually one comparison.
+		// Node handles keep a key's address fixed, which is what lets the ID table point into it.
+		template<typename N, typename Id>
+		using intern_index =
+		   std::conditional_t<hashable<N>, std::unordered_map<N, Id>, std::map<N, Id>>;
+	} // namespace detail
+
+	// A mutable graph that interns every node as a dense std::uint32_t ID when it is inserted.
+	//
+	// A node value is looked up once per call, through a hash table where N can be hashed. The
+	// edges themselves live in a graph<std::uint32_t, E>, so every probe of the edge structure is
+	// an integer comparison instead of a comparison of N. For node types that are expensive to
+	// compare, such as std::string, that is most of the cost of insert_edge, find and friends.
+	// Renaming a node only touches its entry in the table, whatever its degree.
+	//
+	// IDs of erased nodes are reused. Accessors that return nodes sort them by value, like graph's.
+	// Iteration goes in order of (source ID, destination ID, weight), which follows value order only
+	// while nodes are inserted in sorted order; operator<< sorts, and prints what graph would.
+	template<concepts::regular N, concepts::regular E>
+	requires concepts::totally_ordered<N> //
+	   and concepts::totally_ordered<E> //
+
+	   class interned_graph {
+	public:
+		class iterator;
+
+		using id_type = std::uint32_t;
+
+		// ======================================
+		//              Constructors
+		// ======================================
+		interned_graph() = default;
+
+		interned_graph(std::initializer_list<N> il) {
+			for (auto const& value : il) {
+				insert_node(value);
+			}
+		}
+
+		// Nodes are interned in sorted order, so iteration starts out in graph's order.
+		explicit interned_graph(graph<N, E> const& g) {
+			for (auto const& node : g.nodes_view()) {
+				insert_node(node);
+			}
+			for (auto const& [from, to, weight] : g) {
+				edges_.insert_edge(*find_id(from), *find_id(to), weight);
+			}
+		}
+
+		// Copies get their own table, so the IDs' pointers have to be rebuilt against it.
+		interned_graph(interned_graph const& other)
+		: ids_(other.ids_)
+		, free_(other.free_)
+		, edges_(other.edges_) {
+			values_.assign(other.values_.size(), nullptr);
+			for (auto const& [value, id] : ids_) {
+				values_[id] = &value;
+			}
+		}
+
+		interned_graph(interned_graph&&) noexcept = default;
+
+		auto operator=(interned_graph const& other) -> interned_graph& {
+			if (this != &other) {
+				auto temp = other;
+				*this = std::move(temp);
+			}
+			return *this;
+		}
+
+		auto operator=(interned_graph&&) noexcept -> interned_graph& = default;
+
+		~interned_graph() = default;
+
+		// Rebuilds a graph<N, E> holding the same nodes and edges.
+		[[nodiscard]] auto to_graph() const -> graph<N, E> {
+			auto result = graph<N, E>();
+			for (auto const& [value, id] : ids_) {
+				result.insert_node(value);
+			}
+			for (auto const& [from, to, weight] : *this) {
+				result.insert_edge(from, to, weight);
+			}
+			return result;
+		}
+
+		// ======================================
+		//              Modifiers
+		// ======================================
+		auto insert_node(N const& value) -> bool {
+			if (ids_.contains(value)) {
+				return false;
+			}
+			if (free_.empty() and values_.size() > std::numeric_limits<id_type>::max()) {
+				throw std::length_error("Cannot call gdwg::interned_graph<N, E>::insert_node when "
+				                        "every node ID is in use");
+			}
+			auto const id = free_.empty() ? static_cast<id_type>(values_.size()) : free_.back();
+			auto const& key = ids_.emplace(value, id).first->first;
+			if (free_.empty()) {
+				values_.push_back(&key);
+			}
+			else {
+				free_.pop_back();
+				values_[id] = &key;
+			}
+			edges_.insert_node(id);
+			return true;
+		}
+
+		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool {
+			auto src_id = find_id(src);
+			auto dst_id = find_id(dst);
+			if (!src_id || !dst_id) {
+				throw std::runtime_error("Cannot call gdwg::interned_graph<N, E>::insert_edge when "
+				                         "either src or dst node does not exist");
+			}
+			return edges_.insert_edge(*src_id, *dst_id, weight);
+		}
+
+		// O(1) in the degree of the node: its ID and therefore every edge stays where it is.
+		auto replace_node(N const& old_data, N const& new_data) -> bool {
+			auto old_it = ids_.find(old_data);
+			if (old_it == ids_.end()) {
+				throw std::runtime_error("Cannot call gdwg::interned_graph<N, E>::replace_node on a "
+				                         "node that doesn't exist");
+			}
+			if (ids_.contains(new_data)) {
+				return false;
+			}
+			auto handle = ids_.extract(old_it);
+			handle.key() = new_data;
+			ids_.insert(std::move(handle));
+			return true;
+		}
+
+		auto merge_replace_node(N const& old_data, N const& new_data) -> void {
+			auto old_id = find_id(old_data);
+			auto new_id = find_id(new_data);
+			if (!old_id || !new_id) {
+				throw std::runtime_error("Cannot call gdwg::interned_graph<N, E>::merge_replace_node "
+				                         "on old or new data if they don't exist in the graph");
+			}
+			if (*old_id == *new_id) {
+				return;
+			}
+			edges_.merge_replace_node(*old_id, *new_id);
+			release(*old_id);
+		}
+
+		auto erase_node(N const& value) -> bool {
+			auto id = find_id(value);
+			if (!id) {
+				return false;
+			}
+			edges_.erase_node(*id);
+			release(*id);
+			return true;
+		}
+
+		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool {
+			auto src_id = find_id(src);
+			auto dst_id = find_id(dst);
+			if (!src_id || !dst_id) {
+				throw std::runtime_error("Cannot call gdwg::interned_graph<N, E>::erase_edge on src or "
+				                         "dst if they don't exist in the graph");
+			}
+			return edges_.erase_edge(*src_id, *dst_id, weight);
+		}
+
+		auto erase_edge(iterator i) -> iterator {
+			return iterator(*this, edges_.erase_edge(i.inner_));
+		}
+
+		auto clear() noexcept -> void {
+			ids_.clear();
+			values_.clear();
+			free_.clear();
+			edges_.clear();
+		}
+
+		// ======================================
+		//              Accessors
+		// ======================================
+		[[nodiscard]] auto is_node(N const& value) const -> bool {
+			return ids_.contains(value);
+		}
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return ids_.empty();
+		}
+
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool {
+			auto src_id = find_id(src);
+			auto dst_id = find_id(dst);
+			if (!src_id || !dst_id) {
+				throw std::runtime_error("Cannot call gdwg::interned_graph<N, E>::is_connected if src "
+				                         "or dst node don't exist in the graph");
+			}
+			return edges_.is_connected(*src_id, *dst_id);
+		}
+
+		[[nodiscard]] auto nodes() const -> std::vector<N> {
+			auto result = std::vector<N>();
+			result.reserve(ids_.size());
+			for (auto const& [value, id] : ids_) {
+				result.push_back(value);
+			}
+			std::sort(result.begin(), result.end());
+			return result;
+		}
+
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E> {
+			auto src_id = find_id(src);
+			auto dst_id = find_id(dst);
+			if (!src_id || !dst_id) {
+				throw std::runtime_error("Cannot call gdwg::interned_graph<N, E>::weights if src or "
+				                         "dst node don't exist in the graph");
+			}
+			return edges_.weights(*src_id, *dst_id);
+		}
+
+		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const -> iterator {
+			auto src_id = find_id(src);
+			auto dst_id = find_id(dst);
+			if (!src_id || !dst_id) {
+				return end();
+			}
+			return iterator(*this, edges_.find(*src_id, *dst_id, weight));
+		}
+
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N> {
+			auto src_id = find_id(src);
+			if (!src_id) {
+				throw std::runtime_error("Cannot call gdwg::interned_graph<N, E>::connections if src "
+				                         "doesn't exist in the graph");
+			}
+			// Sorting pointers is cheaper than sorting copies of N.
+			auto sorted = std::vector<N const*>();
+			for (auto id : edges_.connections(*src_id)) {
+				sorted.push_back(values_[id]);
+			}
+			std::sort(sorted.begin(), sorted.end(), [](N const* a, N const* b) { return *a < *b; });
+			auto result = std::vector<N>();
+			result.reserve(sorted.size());
+			for (auto const* value : sorted) {
+				result.push_back(*value);
+			}
+			return result;
+		}
+
+		// The node's ID, if it is in the graph. Stable until the node is erased or merged away.
+		[[nodiscard]] auto id(N const& value) const -> std::optional<id_type> {
+			return find_id(value);
+		}
+
+		// The node holding `id`, which must be in use.
+		[[nodiscard]] auto node(id_type id) const -> N const& {
+			return *values_[id];
+		}
+
+		// ======================================
+		//              Range Access
+		// ======================================
+		[[nodiscard]] auto begin() const -> iterator {
+			return iterator(*this, edges_.begin());
+		}
+
+		[[nodiscard]] auto end() const -> iterator {
+			return iterator(*this, edges_.end());
+		}
+
+		// ======================================
+		//              Comparisons
+		// ======================================
+		// Equal when both hold the same nodes and edges, whatever IDs they were given.
+		[[nodiscard]] auto operator==(interned_graph const& other) const -> bool {
+			if (ids_.size() != other.ids_.size()) {
+				return false;
+			}
+			for (auto const& [value, id] : ids_) {
+				if (!other.ids_.contains(value)) {
+					return false;
+				}
+			}
+			auto count = std::size_t{0};
+			for (auto const& [from, to, weight] : *this) {
+				if (other.find(from, to, weight) == other.end()) {
+					return false;
+				}
+				++count;
+			}
+			return count == static_cast<std::size_t>(std::distance(other.begin(), other.end()));
+		}
+
+		// ======================================
+		//              Extractor
+		// ======================================
+		friend auto operator<<(std::ostream& os, interned_graph const& g) -> std::ostream& {
+			return os << g.to_graph();
+		}
+
+		// ======================================
+		//              Iterators
+		// ======================================
+		class iterator {
+			using inner_iterator = typename graph<id_type, E>::iterator;
+
+		public:
+			using value_type = ranges::common_tuple<N, N, E>;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			// Iterator constructor
+			iterator() = default;
+
+			// Iterator source
+			auto operator*() const -> ranges::common_tuple<N const&, N const&, E const&> {
+				auto const& [from, to, weight] = *inner_;
+				return ranges::common_tuple<N const&, N const&, E const&>{pointee_->node(from),
+				                                                          pointee_->node(to),
+				                                                          weight};
+			}
+
+			// Iterator traversal
+			auto operator++() -> iterator& {
+				++inner_;
+				return *this;
+			}
+			auto operator++(int) -> iterator {
+				auto temp = *this;
+				++*this;
+				return temp;
+			}
+			auto operator--() -> iterator& {
+				--inner_;
+				return *this;
+			}
+			auto operator--(int) -> iterator {
+				auto temp = *this;
+				--*this;
+				return temp;
+			}
+
+			// Iterator comparison
+			auto operator==(iterator const& other) const -> bool {
+				return inner_ == other.inner_;
+			}
+
+		private:
+			interned_graph const* pointee_ = nullptr;
+			inner_iterator inner_;
+			friend class interned_graph;
+			explicit iterator(interned_graph const& pointee, inner_iterator inner) noexcept
+			: pointee_(&pointee)
+			, inner_(inner) {}
+		};
+
+	private:
+		detail::intern_index<N, id_type> ids_;
+		// ID -> its key in ids_, or nullptr while the ID is free.
+		std::vector<N const*> values_;
+		std::vector<id_type> free_;
+		graph<id_type, E> edges_;
+
+		auto find_id(N const& value) const -> std::optional<id_type> {
+			auto result = ids_.find(value);
+			if (result == ids_.end()) {
+				return std::nullopt;
+			}
+			return result->second;
+		}
+
+		// Forgets the node holding `id`, whose edges must already be gone, and frees the ID.
+		auto release(id_type id) -> void {
+			ids_.erase(ids_.find(*values_[id]));
+			values_[id] = nullptr;
+			free_.push_back(id);
+		}
+	};
+} // namespace gdwg
+
+#endif // GDWG_INTERNED_GRAPH_HPP
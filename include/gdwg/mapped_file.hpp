@@ -0,0 +1,101 @@
+#ifndef GDWG_MAPPED_FILE_HPP
+#define GDWG_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace gdwg {
+	namespace detail {
+		// A read-only file mapping. `caller` names the function opening it in any error thrown. An
+		// empty file can't be mapped, so it is held as an empty range instead.
+		class mapped_file {
+		public:
+			mapped_file(std::filesystem::path const& path, std::string_view caller) {
+				auto fd = ::open(path.c_str(), O_RDONLY);
+				if (fd == -1) {
+					fail(caller, "that can't be opened");
+				}
+				struct ::stat info = {};
+				if (::fstat(fd, &info) == -1) {
+					::close(fd);
+					fail(caller, "that can't be opened");
+				}
+				size_ = static_cast<std::size_t>(info.st_size);
+				if (size_ == 0) {
+					::close(fd);
+					return;
+				}
+				auto* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+				::close(fd);
+				if (data == MAP_FAILED) {
+					size_ = 0;
+					fail(caller, "that can't be mapped");
+				}
+				data_ = static_cast<char const*>(data);
+			}
+
+			mapped_file(mapped_file&& other) noexcept
+			: data_(std::exchange(other.data_, nullptr))
+			, size_(std::exchange(other.size_, 0)) {}
+
+			auto operator=(mapped_file&& other) noexcept -> mapped_file& {
+				if (this != &other) {
+					unmap();
+					data_ = std::exchange(other.data_, nullptr);
+					size_ = std::exchange(other.size_, 0);
+				}
+				return *this;
+			}
+
+			mapped_file(mapped_file const&) = delete;
+			auto operator=(mapped_file const&) -> mapped_file& = delete;
+
+			~mapped_file() {
+				unmap();
+			}
+
+			[[nodiscard]] auto data() const noexcept -> char const* {
+				return data_;
+			}
+
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return size_;
+			}
+
+			// A hint that the mapping will be read front to back, so the kernel reads ahead
+			// aggressively and drops pages once they are behind the reader.
+			auto advise_sequential() const noexcept -> void {
+				if (data_ != nullptr) {
+					::madvise(const_cast<char*>(data_), size_, MADV_SEQUENTIAL);
+				}
+			}
+
+		private:
+			char const* data_ = nullptr;
+			std::size_t size_ = 0;
+
+			auto unmap() noexcept -> void {
+				if (data_ != nullptr) {
+					::munmap(const_cast<char*>(data_), size_);
+				}
+			}
+
+			[[noreturn]] static auto fail(std::string_view caller, std::string_view reason) -> void {
+				auto message = std::string("Cannot call ");
+				message.append(caller).append(" on a file ").append(reason);
+				throw std::runtime_error(message);
+			}
+		};
+	} // namespace detail
+} // namespace gdwg
+
+#endif // GDWG_MAPPED_FILE_HPP
@@ -0,0 +1,42 @@
+#ifndef GDWG_PARALLEL_HPP
+#define GDWG_PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace gdwg {
+	namespace detail {
+		// Splits [0, size) into contiguous chunks and calls f(first, last, chunk) for each, on
+		// separate threads once there is enough work to pay for them.
+		template<typename F>
+		auto for_each_chunk(std::size_t size, std::size_t chunks, F const& f) -> void {
+			if (chunks == 1) {
+				f(std::size_t{0}, size, std::size_t{0});
+				return;
+			}
+			auto workers = std::vector<std::thread>();
+			workers.reserve(chunks - 1);
+			auto const step = (size + chunks - 1) / chunks;
+			for (auto chunk = std::size_t{1}; chunk < chunks; ++chunk) {
+				workers.emplace_back([&f, step, size, chunk] {
+					f(std::min(size, chunk * step), std::min(size, (chunk + 1) * step), chunk);
+				});
+			}
+			f(std::size_t{0}, std::min(size, step), std::size_t{0});
+			for (auto& worker : workers) {
+				worker.join();
+			}
+		}
+
+		// Below this much work a parallel traversal runs on the calling thread.
+		inline constexpr auto parallel_threshold = std::size_t{1024};
+
+		[[nodiscard]] inline auto hardware_threads() -> std::size_t {
+			return std::max(std::size_t{1}, std::size_t{std::thread::hardware_concurrency()});
+		}
+	} // namespace detail
+} // namespace gdwg
+
+#endif // GDWG_PARALLEL_HPP
@@ -0,0 +1,190 @@
+#ifndef GDWG_QUERY_CACHE_HPP
+#define GDWG_QUERY_CACHE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// The queries whose results a graph can cache, each run from a single source node.
+	enum class cached_query {
+		connections,
+		bfs,
+		parallel_bfs,
+		dfs,
+		dijkstra,
+		bellman_ford,
+	};
+
+	// How a graph's query cache has fared since it was enabled.
+	struct query_cache_stats {
+		// Queries answered from the cache, and queries that had to be run.
+		std::uint64_t hits = 0;
+		std::uint64_t misses = 0;
+		// Cached results dropped because the graph was modified under them.
+		std::uint64_t invalidations = 0;
+		// Results held now.
+		std::size_t entries = 0;
+	};
+
+	namespace detail {
+		// Results of queries on one graph, keyed by (query, source node). Each result lists the
+		// nodes it was worked out from, and each node lists the results that depend on it, so a
+		// modification drops exactly the results that might have changed. Lookups are locked, as
+		// a const graph may be queried from several threads at once; a missed query is run
+		// outside the lock. Invalidation is not: only the graph's modifiers invalidate, and no
+		// query may run alongside a modifier, so there is never a lookup to exclude.
+		template<typename N>
+		class query_cache {
+		public:
+			// The cached result of `query` from `src`, or else compute(), which is cached along with
+			// the nodes it depends on, given by depends_on(result). `src` has to be one of them.
+			template<typename R, typename Compute, typename DependsOn>
+			auto get(cached_query query,
+			         N const* src,
+			         Compute const& compute,
+			         DependsOn const& depends_on) -> R {
+				auto const key = entry_key{query, src};
+				{
+					auto const lock = std::scoped_lock(mutex_);
+					if (auto it = entries_.find(key); it != entries_.end()) {
+						++stats_.hits;
+						return *std::static_pointer_cast<R const>(it->second.result);
+					}
+					++stats_.misses;
+				}
+				auto result = std::make_shared<R const>(compute());
+				auto nodes = depends_on(*result);
+				std::sort(nodes.begin(), nodes.end());
+				nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+				auto const lock = std::scoped_lock(mutex_);
+				if (auto [it, inserted] = entries_.try_emplace(key); inserted) {
+					for (auto const* node : nodes) {
+						dependents_[node].push_back(key);
+					}
+					it->second = entry{result, std::move(nodes)};
+					++counts_[static_cast<std::size_t>(query)];
+				}
+				return *result;
+			}
+
+			// The cached result of `query` from `src`, or null. Finding one counts as a hit; nothing
+			// is run or cached when there is none.
+			template<typename R>
+			auto find(cached_query query, N const* src) -> std::shared_ptr<R const> {
+				auto const lock = std::scoped_lock(mutex_);
+				if (auto it = entries_.find(entry_key{query, src}); it != entries_.end()) {
+					++stats_.hits;
+					return std::static_pointer_cast<R const>(it->second.result);
+				}
+				return nullptr;
+			}
+
+			// Drops every result that depends on `node`.
+			auto invalidate(N const* node) noexcept -> void {
+				auto it = dependents_.find(node);
+				if (it == dependents_.end()) {
+					return;
+				}
+				auto const keys = std::move(it->second);
+				dependents_.erase(it);
+				for (auto const& key : keys) {
+					drop(key);
+				}
+			}
+
+			// Drops every result of `query`, whatever it depends on.
+			auto invalidate(cached_query query) noexcept -> void {
+				if (counts_[static_cast<std::size_t>(query)] == 0) {
+					return;
+				}
+				for (auto it = entries_.begin(); it != entries_.end();) {
+					auto const key = it->first;
+					++it;
+					if (key.query == query) {
+						drop(key);
+					}
+				}
+			}
+
+			auto clear() noexcept -> void {
+				stats_.invalidations += entries_.size();
+				entries_.clear();
+				dependents_.clear();
+				counts_.fill(0);
+			}
+
+			[[nodiscard]] auto stats() const -> query_cache_stats {
+				auto const lock = std::scoped_lock(mutex_);
+				auto result = stats_;
+				result.entries = entries_.size();
+				return result;
+			}
+
+		private:
+			static constexpr auto query_count =
+			   static_cast<std::size_t>(cached_query::bellman_ford) + 1;
+
+			struct entry_key {
+				cached_query query;
+				N const* src;
+
+				auto operator==(entry_key const&) const -> bool = default;
+			};
+			struct entry_hash {
+				auto operator()(entry_key const& key) const noexcept -> std::size_t {
+					return std::hash<N const*>()(key.src) ^ static_cast<std::size_t>(key.query);
+				}
+			};
+			struct entry {
+				std::shared_ptr<void const> result;
+				std::vector<N const*> depends_on;
+			};
+
+			mutable std::mutex mutex_;
+			std::unordered_map<entry_key, entry, entry_hash> entries_;
+			std::unordered_map<N const*, std::vector<entry_key>> dependents_;
+			query_cache_stats stats_;
+			// How many results of each query are held, so dropping every result of a query costs
+			// nothing when there are none.
+			std::array<std::size_t, query_count> counts_{};
+
+			// Drops one result, and its key from every other node it depends on.
+			auto drop(entry_key const& key) noexcept -> void {
+				auto it = entries_.find(key);
+				if (it == entries_.end()) {
+					return;
+				}
+				for (auto const* node : it->second.depends_on) {
+					auto keys = dependents_.find(node);
+					if (keys == dependents_.end()) {
+						continue;
+					}
+					auto& list = keys->second;
+					for (auto i = std::size_t{0}; i < list.size(); ++i) {
+						if (list[i] == key) {
+							list[i] = list.back();
+							list.pop_back();
+							break;
+						}
+					}
+					if (list.empty()) {
+						dependents_.erase(keys);
+					}
+				}
+				--counts_[static_cast<std::size_t>(key.query)];
+				entries_.erase(it);
+				++stats_.invalidations;
+			}
+		};
+	} // namespace detail
+} // namespace gdwg
+
+#endif // GDWG_QUERY_CACHE_HPP
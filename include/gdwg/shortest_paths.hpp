@@ -0,0 +1,517 @@
+#ifndef GDWG_SHORTEST_PATHS_HPP
+#define GDWG_SHORTEST_PATHS_HPP
+
+#include "gdwg/graph.hpp"
+#include "gdwg/graph_algorithms.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	// The result of a single-source shortest path search. Only nodes whose distance is final appear:
+	// every node reachable from the source, or after an early exit at a target, every node settled
+	// before the search stopped. The source has a distance but no predecessor.
+	template<typename N, typename E>
+	struct shortest_path_tree {
+		std::map<N, E> distance;
+		std::map<N, N> predecessor;
+	};
+
+	namespace detail {
+		// A flat, index-based copy of a graph for the path searches. Only the lightest weight of
+		// each (src, dst) pair is kept, since no shortest path uses a heavier parallel edge.
+		template<typename N, typename E>
+		class path_index {
+		public:
+			static constexpr auto npos = static_cast<std::size_t>(-1);
+
+			explicit path_index(graph<N, E> const& g) {
+				// Every edge's destination is looked up by address, so building the index is linear.
+				auto ids = std::unordered_map<N const*, std::size_t>();
+				for (auto const& node : g.nodes_view()) {
+					ids.emplace(&node, nodes_.size());
+					nodes_.push_back(&node);
+				}
+				offsets_.reserve(nodes_.size() + 1);
+				offsets_.push_back(0);
+				// Edges arrive ordered by (src, dst, weight), so the first weight of a pair is its
+				// lightest. Nodes are unique by value, so comparing addresses finds repeated pairs.
+				auto src = std::size_t{0};
+				auto last_dst = static_cast<N const*>(nullptr);
+				for (auto const& [from, to, weight] : g.edges_view()) {
+					if (nodes_[src] != &from) {
+						while (nodes_[src] != &from) {
+							offsets_.push_back(dsts_.size());
+							++src;
+						}
+						last_dst = nullptr;
+					}
+					if (last_dst == &to) {
+						continue;
+					}
+					last_dst = &to;
+					dsts_.push_back(ids.find(&to)->second);
+					weights_.push_back(weight);
+					negative_weights_ = negative_weights_ or weight < E{};
+				}
+				while (offsets_.size() < nodes_.size() + 1) {
+					offsets_.push_back(dsts_.size());
+				}
+			}
+
+			template<typename K>
+			[[nodiscard]] auto find(K const& value) const -> std::size_t {
+				auto result = std::lower_bound(nodes_.begin(),
+				                               nodes_.end(),
+				                               value,
+				                               [](N const* node, K const& key) { return *node < key; });
+				if (result == nodes_.end() || **result != value) {
+					return npos;
+				}
+				return static_cast<std::size_t>(result - nodes_.begin());
+			}
+
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return nodes_.size();
+			}
+
+			[[nodiscard]] auto node(std::size_t i) const -> N const& {
+				return *nodes_[i];
+			}
+
+			// Calls f(dst, weight) for every outgoing edge of src.
+			template<typename F>
+			auto for_each_edge(std::size_t src, F&& f) const -> void {
+				for (auto i = offsets_[src]; i != offsets_[src + 1]; ++i) {
+					f(dsts_[i], weights_[i]);
+				}
+			}
+
+			[[nodiscard]] auto has_negative_weights() const noexcept -> bool {
+				return negative_weights_;
+			}
+
+		private:
+			std::vector<N const*> nodes_;
+			std::vector<std::size_t> offsets_;
+			std::vector<std::size_t> dsts_;
+			std::vector<E> weights_;
+			bool negative_weights_ = false;
+		};
+
+		// Per-node search state, indexed like path_index.
+		template<typename E>
+		struct search_state {
+			static constexpr auto npos = static_cast<std::size_t>(-1);
+
+			explicit search_state(std::size_t size)
+			: distance(size)
+			, predecessor(size, npos)
+			, reached(size, false)
+			, settled(size, false) {}
+
+			std::vector<E> distance;
+			std::vector<std::size_t> predecessor;
+			std::vector<bool> reached;
+			std::vector<bool> settled;
+
+			// Records `candidate` as the distance to `dst` through `src` if it improves on what is
+			// known.
+			auto relax(std::size_t src, std::size_t dst, E const& candidate) -> bool {
+				if (reached[dst] and not(candidate < distance[dst])) {
+					return false;
+				}
+				distance[dst] = candidate;
+				predecessor[dst] = src;
+				reached[dst] = true;
+				return true;
+			}
+		};
+
+		// A 4-ary min-heap of (distance, node) entries in one contiguous vector. The shallower tree
+		// keeps a sift-down within a cache line or two, and stale entries are skipped on pop rather
+		// than updated in place.
+		template<typename E>
+		class quaternary_heap {
+		public:
+			using entry = std::pair<E, std::size_t>;
+
+			[[nodiscard]] auto empty() const noexcept -> bool {
+				return entries_.empty();
+			}
+
+			auto push(E const& distance, std::size_t node) -> void {
+				entries_.emplace_back(distance, node);
+				auto i = entries_.size() - 1;
+				while (i > 0) {
+					auto parent = (i - 1) / arity;
+					if (not(entries_[i].first < entries_[parent].first)) {
+						break;
+					}
+					std::swap(entries_[i], entries_[parent]);
+					i = parent;
+				}
+			}
+
+			auto pop() -> entry {
+				auto result = std::move(entries_.front());
+				entries_.front() = std::move(entries_.back());
+				entries_.pop_back();
+				auto i = std::size_t{0};
+				while (true) {
+					auto const first_child = arity * i + 1;
+					if (first_child >= entries_.size()) {
+						break;
+					}
+					auto const last_child = std::min(first_child + arity, entries_.size());
+					auto smallest = first_child;
+					for (auto child = first_child + 1; child < last_child; ++child) {
+						if (entries_[child].first < entries_[smallest].first) {
+							smallest = child;
+						}
+					}
+					if (not(entries_[smallest].first < entries_[i].first)) {
+						break;
+					}
+					std::swap(entries_[i], entries_[smallest]);
+					i = smallest;
+				}
+				return result;
+			}
+
+		private:
+			static constexpr auto arity = std::size_t{4};
+			std::vector<entry> entries_;
+		};
+
+		// distance + weight, the length of a path extended by one edge. For an integral E a length
+		// that E can't hold throws `overflow` rather than wrapping into a wrong distance.
+		template<typename E>
+		auto path_length(E const& distance, E const& weight, char const* overflow) -> E {
+			if constexpr (std::is_integral_v<E>) {
+				if ((E{} < weight and std::numeric_limits<E>::max() - weight < distance)
+				    or (weight < E{} and distance < std::numeric_limits<E>::min() - weight)) {
+					throw std::overflow_error(overflow);
+				}
+			}
+			return static_cast<E>(distance + weight);
+		}
+
+		template<typename N, typename E>
+		auto make_tree(path_index<N, E> const& index, search_state<E> const& state)
+		   -> shortest_path_tree<N, E> {
+			auto result = shortest_path_tree<N, E>();
+			// Indices follow node order, so every insertion lands at the end.
+			for (auto i = std::size_t{0}; i < index.size(); ++i) {
+				if (not state.settled[i]) {
+					continue;
+				}
+				result.distance.emplace_hint(result.distance.end(), index.node(i), state.distance[i]);
+				if (state.predecessor[i] != search_state<E>::npos) {
+					result.predecessor.emplace_hint(result.predecessor.end(),
+					                                index.node(i),
+					                                index.node(state.predecessor[i]));
+				}
+			}
+			return result;
+		}
+
+		// What a cached search from one source depends on: every node it reached.
+		inline constexpr auto tree_nodes = [](auto const& tree, auto const& note) {
+			for (auto const& [node, distance] : tree.distance) {
+				note(node);
+			}
+		};
+
+		template<typename N, typename E>
+		auto run_dijkstra(path_index<N, E> const& index, std::size_t source, std::size_t target)
+		   -> shortest_path_tree<N, E> {
+			if (index.has_negative_weights()) {
+				throw std::runtime_error("Cannot call gdwg::dijkstra on a graph with negative edge "
+				                         "weights");
+			}
+			auto state = search_state<E>(index.size());
+			auto heap = quaternary_heap<E>();
+			state.relax(search_state<E>::npos, source, E{});
+			heap.push(E{}, source);
+			while (not heap.empty()) {
+				auto [distance, node] = heap.pop();
+				if (state.settled[node] or state.distance[node] < distance) {
+					continue;
+				}
+				state.settled[node] = true;
+				if (node == target) {
+					break;
+				}
+				index.for_each_edge(node, [&](std::size_t dst, E const& weight) {
+					if (state.settled[dst]) {
+						return;
+					}
+					auto const length = path_length(distance,
+					                                weight,
+					                                "Cannot call gdwg::dijkstra when a path length "
+					                                "overflows the weight type");
+					if (state.relax(node, dst, length)) {
+						heap.push(state.distance[dst], dst);
+					}
+				});
+			}
+			return make_tree(index, state);
+		}
+
+		template<typename N, typename E>
+		auto run_bellman_ford(path_index<N, E> const& index, std::size_t source)
+		   -> shortest_path_tree<N, E> {
+			auto state = search_state<E>(index.size());
+			state.relax(search_state<E>::npos, source, E{});
+			// Only nodes whose distance changed in the last round can improve anything in the next,
+			// so each round relaxes the edges of that frontier alone.
+			auto frontier = std::vector<std::size_t>{source};
+			auto next = std::vector<std::size_t>();
+			auto queued = std::vector<bool>(index.size(), false);
+			for (auto round = std::size_t{0}; not frontier.empty(); ++round) {
+				if (round == index.size()) {
+					throw std::runtime_error("Cannot call gdwg::bellman_ford on a graph with a negative "
+					                         "cycle reachable from src");
+				}
+				for (auto node : frontier) {
+					index.for_each_edge(node, [&](std::size_t dst, E const& weight) {
+						auto const length = path_length(state.distance[node],
+						                                weight,
+						                                "Cannot call gdwg::bellman_ford when a path "
+						                                "length overflows the weight type");
+						if (state.relax(node, dst, length) and not queued[dst]) {
+							queued[dst] = true;
+							next.push_back(dst);
+						}
+					});
+				}
+				for (auto node : next) {
+					queued[node] = false;
+				}
+				std::swap(frontier, next);
+				next.clear();
+			}
+			state.settled = state.reached;
+			return make_tree(index, state);
+		}
+
+		template<typename N, typename E>
+		auto run_delta_stepping(path_index<N, E> const& index,
+		                        std::size_t source,
+		                        std::size_t target,
+		                        E const& delta) -> shortest_path_tree<N, E> {
+			if (index.has_negative_weights()) {
+				throw std::runtime_error("Cannot call gdwg::delta_stepping on a graph with negative "
+				                         "edge weights");
+			}
+			if (not(E{} < delta)) {
+				throw std::runtime_error("Cannot call gdwg::delta_stepping with a delta that isn't "
+				                         "positive");
+			}
+			auto const threads = hardware_threads();
+
+			// The edge's weight travels with the distance its source had when the request was made,
+			// and the two are added, checked, on the calling thread.
+			struct request {
+				std::size_t src;
+				std::size_t dst;
+				E distance;
+				E weight;
+			};
+			auto state = search_state<E>(index.size());
+			// Only buckets that hold a node exist, keyed by their number, which for a floating-point
+			// E stays an E: the largest distance over a small delta is no bound on how many there
+			// are, nor does it fit a std::size_t.
+			auto buckets = std::map<E, std::vector<std::size_t>>();
+			auto bucket_of = [&delta](E const& distance) -> E {
+				if constexpr (std::is_floating_point_v<E>) {
+					return std::floor(distance / delta);
+				}
+				else {
+					return static_cast<E>(distance / delta);
+				}
+			};
+			auto apply = [&](std::vector<std::vector<request>>& requests) {
+				for (auto& chunk : requests) {
+					for (auto const& [src, dst, distance, weight] : chunk) {
+						auto const length = path_length(distance,
+						                                weight,
+						                                "Cannot call gdwg::delta_stepping when a path "
+						                                "length overflows the weight type");
+						if (state.relax(src, dst, length)) {
+							buckets[bucket_of(length)].push_back(dst);
+						}
+					}
+					chunk.clear();
+				}
+			};
+			// Every node of `frontier` relaxes its light or heavy edges. The requests are generated
+			// in parallel against a frozen view of the distances, then applied in frontier order, so
+			// the result doesn't depend on the number of threads.
+			auto requests = std::vector<std::vector<request>>(threads);
+			auto relax_edges = [&](std::vector<std::size_t> const& frontier, bool light) {
+				auto const chunks = frontier.size() < parallel_threshold ? 1 : threads;
+				for_each_chunk(frontier.size(),
+				               chunks,
+				               [&](std::size_t first, std::size_t last, std::size_t chunk) {
+					               for (auto i = first; i != last; ++i) {
+						               auto const node = frontier[i];
+						               index.for_each_edge(node, [&](std::size_t dst, E const& weight) {
+							               if ((delta < weight) != light) {
+								               requests[chunk].push_back(
+								                  {node, dst, state.distance[node], weight});
+							               }
+						               });
+					               }
+				               });
+				apply(requests);
+			};
+
+			state.relax(search_state<E>::npos, source, E{});
+			buckets[E{}].push_back(source);
+			auto frontier = std::vector<std::size_t>();
+			auto removed = std::vector<std::size_t>();
+			while (not buckets.empty()) {
+				// Relaxing never reaches a bucket before the current one, so it stays the first.
+				auto const current = buckets.begin()->first;
+				auto& bucket = buckets.begin()->second;
+				removed.clear();
+				while (not bucket.empty()) {
+					frontier.clear();
+					for (auto node : bucket) {
+						// Skip entries left behind by a later improvement, and repeats.
+						if (bucket_of(state.distance[node]) == current and not state.settled[node]) {
+							state.settled[node] = true;
+							frontier.push_back(node);
+						}
+					}
+					bucket.clear();
+					// Nodes re-entering this bucket must be processed again.
+					for (auto node : frontier) {
+						state.settled[node] = false;
+						removed.push_back(node);
+					}
+					relax_edges(frontier, true);
+				}
+				std::sort(removed.begin(), removed.end());
+				removed.erase(std::unique(removed.begin(), removed.end()), removed.end());
+				relax_edges(removed, false);
+				// Every distance in this bucket is now final.
+				for (auto node : removed) {
+					state.settled[node] = true;
+				}
+				buckets.erase(buckets.begin());
+				if (target != search_state<E>::npos and state.settled[target]) {
+					break;
+				}
+			}
+			return make_tree(index, state);
+		}
+	} // namespace detail
+
+	// Dijkstra's algorithm from `src`, for graphs without negative weights. Cached on a graph with a
+	// query cache, like bellman_ford below.
+	template<typename N, typename E, typename K = N>
+	requires std::is_arithmetic_v<E> and node_key<K, N>
+	[[nodiscard]] auto dijkstra(graph<N, E> const& g, K const& src) -> shortest_path_tree<N, E> {
+		return detail::cached(g, cached_query::dijkstra, src, detail::tree_nodes, [&] {
+			auto const index = detail::path_index<N, E>(g);
+			auto const source = index.find(src);
+			if (source == index.npos) {
+				throw std::runtime_error("Cannot call gdwg::dijkstra if src doesn't exist in the "
+				                         "graph");
+			}
+			return detail::run_dijkstra(index, source, index.npos);
+		});
+	}
+
+	// As above, but stops as soon as the distance to `dst` is known. Only the search stops early:
+	// the whole graph is still indexed first, in O(V + E), and checked for negative weights, so
+	// this saves the heap work beyond `dst` and nothing of the setup. A full tree from `src` held
+	// by the query cache is returned instead, as every distance in it is final.
+	template<typename N, typename E, typename K1 = N, typename K2 = N>
+	requires std::is_arithmetic_v<E> and node_key<K1, N> and node_key<K2, N>
+	[[nodiscard]] auto dijkstra(graph<N, E> const& g, K1 const& src, K2 const& dst)
+	   -> shortest_path_tree<N, E> {
+		using tree = shortest_path_tree<N, E>;
+		if (auto full = detail::cached_result<tree>(g, cached_query::dijkstra, src);
+		    full != nullptr and g.is_node(dst)) {
+			return *full;
+		}
+		auto const index = detail::path_index<N, E>(g);
+		auto const source = index.find(src);
+		auto const target = index.find(dst);
+		if (source == index.npos || target == index.npos) {
+			throw std::runtime_error("Cannot call gdwg::dijkstra if src or dst node don't exist in "
+			                         "the graph");
+		}
+		return detail::run_dijkstra(index, source, target);
+	}
+
+	// Bellman-Ford from `src`, which allows negative weights. It stops as soon as a round changes
+	// nothing, and throws if a negative cycle is reachable from `src`.
+	template<typename N, typename E, typename K = N>
+	requires std::is_arithmetic_v<E> and node_key<K, N>
+	[[nodiscard]] auto bellman_ford(graph<N, E> const& g, K const& src) -> shortest_path_tree<N, E> {
+		return detail::cached(g, cached_query::bellman_ford, src, detail::tree_nodes, [&] {
+			auto const index = detail::path_index<N, E>(g);
+			auto const source = index.find(src);
+			if (source == index.npos) {
+				throw std::runtime_error("Cannot call gdwg::bellman_ford if src doesn't exist in the "
+				                         "graph");
+			}
+			return detail::run_bellman_ford(index, source);
+		});
+	}
+
+	// Delta-stepping from `src`, for graphs without negative weights. Nodes are processed in
+	// buckets of width `delta`, and the edges of each bucket are relaxed by all hardware threads.
+	// A delta around the average weight divided by the average out-degree is a good start.
+	template<typename N, typename E, typename K = N>
+	requires std::is_arithmetic_v<E> and node_key<K, N>
+	[[nodiscard]] auto delta_stepping(graph<N, E> const& g, K const& src, E const& delta)
+	   -> shortest_path_tree<N, E> {
+		auto const index = detail::path_index<N, E>(g);
+		auto const source = index.find(src);
+		if (source == index.npos) {
+			throw std::runtime_error("Cannot call gdwg::delta_stepping if src doesn't exist in the "
+			                         "graph");
+		}
+		return detail::run_delta_stepping(index, source, index.npos, delta);
+	}
+
+	// As above, but stops once the bucket holding `dst` is finished. As with dijkstra's early exit,
+	// the setup is still that of the full search, and a cached dijkstra tree from `src` is
+	// returned instead when there is one.
+	template<typename N, typename E, typename K1 = N, typename K2 = N>
+	requires std::is_arithmetic_v<E> and node_key<K1, N> and node_key<K2, N>
+	[[nodiscard]] auto
+	delta_stepping(graph<N, E> const& g, K1 const& src, K2 const& dst, E const& delta)
+	   -> shortest_path_tree<N, E> {
+		using tree = shortest_path_tree<N, E>;
+		if (auto full = detail::cached_result<tree>(g, cached_query::dijkstra, src);
+		    full != nullptr and g.is_node(dst) and E{} < delta) {
+			return *full;
+		}
+		auto const index = detail::path_index<N, E>(g);
+		auto const source = index.find(src);
+		auto const target = index.find(dst);
+		if (source == index.npos || target == index.npos) {
+			throw std::runtime_error("Cannot call gdwg::delta_stepping if src or dst node don't "
+			                         "exist in the graph");
+		}
+		return detail::run_delta_stepping(index, source, target, delta);
+	}
+} // namespace gdwg
+
+#endif // GDWG_SHORTEST_PATHS_HPP
@@ -0,0 +1,185 @@
+#ifndef GDWG_SIMD_SEARCH_HPP
+#define GDWG_SIMD_SEARCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace gdwg {
+	namespace detail {
+		// Values that can be compared a vector register at a time. Every arithmetic type takes the
+		// same path, but only 4- and 8-byte ones have vector comparisons; the rest, and any build
+		// without SSE2, count with a scalar loop.
+		template<typename T>
+		concept simd_searchable = std::is_arithmetic_v<T> and not std::is_same_v<T, bool>;
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#if defined(__AVX2__)
+		using simd_block = __m256i;
+#else
+		using simd_block = __m128i;
+#endif
+
+		// Whether T has a vector less-than. 8-byte integers need AVX2 or SSE4.2.
+		template<typename T>
+		inline constexpr bool has_vector_less =
+		   std::is_same_v<T, float> or std::is_same_v<T, double>
+		   or (std::is_integral_v<T> and sizeof(T) == 4)
+#if defined(__AVX2__) || defined(__SSE4_2__)
+		   or (std::is_integral_v<T> and sizeof(T) == 8)
+#endif
+		   ;
+
+		// A block with every lane set where the element of data is less than value.
+		template<typename T>
+		auto less_mask(T const* data, T value) noexcept -> simd_block {
+#if defined(__AVX2__)
+			if constexpr (std::is_same_v<T, float>) {
+				return _mm256_castps_si256(
+				   _mm256_cmp_ps(_mm256_loadu_ps(data), _mm256_set1_ps(value), _CMP_LT_OQ));
+			}
+			else if constexpr (std::is_same_v<T, double>) {
+				return _mm256_castpd_si256(
+				   _mm256_cmp_pd(_mm256_loadu_pd(data), _mm256_set1_pd(value), _CMP_LT_OQ));
+			}
+#else
+			if constexpr (std::is_same_v<T, float>) {
+				return _mm_castps_si128(_mm_cmplt_ps(_mm_loadu_ps(data), _mm_set1_ps(value)));
+			}
+			else if constexpr (std::is_same_v<T, double>) {
+				return _mm_castpd_si128(_mm_cmplt_pd(_mm_loadu_pd(data), _mm_set1_pd(value)));
+			}
+#endif
+			else {
+				// The comparisons are signed, so unsigned values are shifted into signed range by
+				// flipping their top bit, which keeps their order.
+				using lane = std::conditional_t<sizeof(T) == 4, std::int32_t, std::int64_t>;
+				constexpr auto flip =
+				   std::is_signed_v<T> ? lane{0} : static_cast<lane>(lane{1} << (8 * sizeof(T) - 1));
+				auto const x = static_cast<lane>(value) ^ flip;
+#if defined(__AVX2__)
+				auto const block =
+				   _mm256_loadu_si256(reinterpret_cast<simd_block const*>(data));
+				if constexpr (sizeof(T) == 4) {
+					auto const bias = _mm256_set1_epi32(flip);
+					return _mm256_cmpgt_epi32(_mm256_set1_epi32(x), _mm256_xor_si256(block, bias));
+				}
+				else {
+					auto const bias = _mm256_set1_epi64x(flip);
+					return _mm256_cmpgt_epi64(_mm256_set1_epi64x(x), _mm256_xor_si256(block, bias));
+				}
+#else
+				auto const block = _mm_loadu_si128(reinterpret_cast<simd_block const*>(data));
+				if constexpr (sizeof(T) == 4) {
+					auto const bias = _mm_set1_epi32(flip);
+					return _mm_cmpgt_epi32(_mm_set1_epi32(x), _mm_xor_si128(block, bias));
+				}
+				else {
+#if defined(__SSE4_2__)
+					auto const bias = _mm_set1_epi64x(flip);
+					return _mm_cmpgt_epi64(_mm_set1_epi64x(x), _mm_xor_si128(block, bias));
+#endif
+				}
+#endif
+			}
+		}
+
+		// The sum of the 4- or 8-byte lanes of a block.
+		template<std::size_t LaneSize>
+		auto sum_lanes(simd_block totals) noexcept -> std::size_t {
+#if defined(__AVX2__)
+			auto const low = _mm256_castsi256_si128(totals);
+			auto const high = _mm256_extracti128_si256(totals, 1);
+			auto sum = LaneSize == 4 ? _mm_add_epi32(low, high) : _mm_add_epi64(low, high);
+#else
+			auto sum = totals;
+#endif
+			if constexpr (LaneSize == 4) {
+				sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4e));
+				sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xb1));
+				return static_cast<std::size_t>(static_cast<std::uint32_t>(_mm_cvtsi128_si32(sum)));
+			}
+			else {
+				sum = _mm_add_epi64(sum, _mm_unpackhi_epi64(sum, sum));
+				return static_cast<std::size_t>(_mm_cvtsi128_si64(sum));
+			}
+		}
+
+		// Adds the elements of whole blocks of [data, data + size) that are less than `value` to
+		// count, and returns how many elements it covered. A set lane is -1, so subtracting each
+		// mask counts matches lane by lane, and the lanes are only summed once at the end.
+		template<typename T>
+		auto count_below_blocks(T const* data, std::size_t size, T value, std::size_t& count) noexcept
+		   -> std::size_t {
+			constexpr auto lanes = sizeof(simd_block) / sizeof(T);
+			if constexpr (not has_vector_less<T>) {
+				return 0;
+			}
+			else if (size < lanes) {
+				return 0;
+			}
+			else {
+#if defined(__AVX2__)
+				auto totals = _mm256_setzero_si256();
+				auto const subtract = [](simd_block a, simd_block b) {
+					return sizeof(T) == 4 ? _mm256_sub_epi32(a, b) : _mm256_sub_epi64(a, b);
+				};
+#else
+				auto totals = _mm_setzero_si128();
+				auto const subtract = [](simd_block a, simd_block b) {
+					return sizeof(T) == 4 ? _mm_sub_epi32(a, b) : _mm_sub_epi64(a, b);
+				};
+#endif
+				auto i = std::size_t{0};
+				for (; i + lanes <= size; i += lanes) {
+					totals = subtract(totals, less_mask(data + i, value));
+				}
+				count += sum_lanes<sizeof(T)>(totals);
+				return i;
+			}
+		}
+#else
+		template<typename T>
+		auto count_below_blocks(T const*, std::size_t, T, std::size_t&) noexcept -> std::size_t {
+			return 0;
+		}
+#endif
+
+		// The number of elements of [data, data + size) less than `value`. The range needn't be
+		// sorted.
+		template<simd_searchable T>
+		auto count_below(T const* data, std::size_t size, T value) noexcept -> std::size_t {
+			auto count = std::size_t{0};
+			auto i = count_below_blocks(data, size, value, count);
+			for (; i < size; ++i) {
+				count += data[i] < value;
+			}
+			return count;
+		}
+
+		// std::lower_bound over a sorted range. A binary search narrows the range down to a window a
+		// few cache lines wide, and the window is then counted a vector at a time, trading the
+		// last, least predictable branches of the search for a handful of comparisons that run in
+		// parallel.
+		template<simd_searchable T>
+		auto simd_lower_bound(T const* first, T const* last, T value) noexcept -> T const* {
+			constexpr auto window = std::ptrdiff_t{256 / sizeof(T)};
+			while (last - first > window) {
+				auto const* middle = first + (last - first) / 2;
+				if (*middle < value) {
+					first = middle + 1;
+				}
+				else {
+					last = middle;
+				}
+			}
+			return first + count_below(first, static_cast<std::size_t>(last - first), value);
+		}
+	} // namespace detail
+} // namespace gdwg
+
+#endif // GDWG_SIMD_SEARCH_HPP
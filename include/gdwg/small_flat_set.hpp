@@ -0,0 +1,315 @@
+#ifndef GDWG_SMALL_FLAT_SET_HPP
+#define GDWG_SMALL_FLAT_SET_HPP
+
+#include "gdwg/simd_search.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+namespace gdwg {
+	namespace detail {
+		// A sorted set of unique values stored contiguously, used for the weights of one
+		// (src, dst) pair. Up to Inline values live inside the object itself, so the common pair with
+		// a single weight costs no allocation at all; beyond that they spill into one buffer from the
+		// allocator, which doubles as it grows. Inline defaults to as many values as fit in two
+		// pointers, but never fewer than one: four ints, two doubles, or one std::string, which
+		// makes the inline storage as large as a std::string.
+		//
+		// It follows std::set's interface for what the graph needs, with one difference: iterators
+		// are pointers, so inserting into or erasing from a set invalidates that set's iterators.
+		template<typename T,
+		         std::size_t Inline = std::max(std::size_t{1}, 2 * sizeof(void*) / sizeof(T))>
+		requires(Inline > 0)
+		class small_flat_set {
+		public:
+			using value_type = T;
+			using key_type = T;
+			using size_type = std::size_t;
+			using difference_type = std::ptrdiff_t;
+			using allocator_type = std::pmr::polymorphic_allocator<T>;
+			// Elements are keys, so like std::set's they are never mutable.
+			using const_iterator = T const*;
+			using iterator = const_iterator;
+
+			small_flat_set() noexcept {}
+
+			explicit small_flat_set(allocator_type alloc) noexcept
+			: alloc_(alloc) {}
+
+			small_flat_set(small_flat_set const& other)
+			: small_flat_set(other, allocator_type()) {}
+
+			small_flat_set(small_flat_set const& other, allocator_type alloc)
+			: alloc_(alloc) {
+				append(other.begin(), other.end());
+			}
+
+			small_flat_set(small_flat_set&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+			: alloc_(other.alloc_) {
+				steal(other);
+			}
+
+			small_flat_set(small_flat_set&& other, allocator_type alloc)
+			: alloc_(alloc) {
+				if (alloc_ == other.alloc_) {
+					steal(other);
+				}
+				else {
+					append(std::make_move_iterator(other.data()),
+					       std::make_move_iterator(other.data() + other.size_));
+				}
+			}
+
+			auto operator=(small_flat_set const& other) -> small_flat_set& {
+				if (this != &other) {
+					clear();
+					append(other.begin(), other.end());
+				}
+				return *this;
+			}
+
+			auto operator=(small_flat_set&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+			   -> small_flat_set& {
+				if (this == &other) {
+					return *this;
+				}
+				if (alloc_ == other.alloc_) {
+					release();
+					steal(other);
+				}
+				else {
+					clear();
+					append(std::make_move_iterator(other.data()),
+					       std::make_move_iterator(other.data() + other.size_));
+				}
+				return *this;
+			}
+
+			~small_flat_set() {
+				release();
+			}
+
+			[[nodiscard]] auto get_allocator() const noexcept -> allocator_type {
+				return alloc_;
+			}
+
+			// ======================================
+			//              Range Access
+			// ======================================
+			[[nodiscard]] auto begin() const noexcept -> const_iterator {
+				return data();
+			}
+
+			[[nodiscard]] auto end() const noexcept -> const_iterator {
+				return data() + size_;
+			}
+
+			[[nodiscard]] auto size() const noexcept -> size_type {
+				return size_;
+			}
+
+			[[nodiscard]] auto empty() const noexcept -> bool {
+				return size_ == 0;
+			}
+
+			// ======================================
+			//              Lookup
+			// ======================================
+			// Arithmetic values are searched a vector at a time.
+			[[nodiscard]] auto lower_bound(T const& value) const -> const_iterator {
+				if constexpr (simd_searchable<T>) {
+					return simd_lower_bound(begin(), end(), value);
+				}
+				else {
+					return std::lower_bound(begin(), end(), value);
+				}
+			}
+
+			[[nodiscard]] auto find(T const& value) const -> const_iterator {
+				auto result = lower_bound(value);
+				return result != end() and not(value < *result) ? result : end();
+			}
+
+			[[nodiscard]] auto contains(T const& value) const -> bool {
+				return find(value) != end();
+			}
+
+			// ======================================
+			//              Modifiers
+			// ======================================
+			auto insert(T const& value) -> std::pair<iterator, bool> {
+				auto position = lower_bound(value);
+				if (position != end() and not(value < *position)) {
+					return {position, false};
+				}
+				return {insert_at(position, value), true};
+			}
+
+			// Constant time, plus the shift, when value belongs just before hint, as it does for
+			// values inserted in ascending order with an end() hint.
+			auto insert(const_iterator hint, T const& value) -> iterator {
+				if ((hint == end() or value < *hint) and (hint == begin() or *(hint - 1) < value)) {
+					return insert_at(hint, value);
+				}
+				return insert(value).first;
+			}
+
+			auto erase(const_iterator position) -> iterator {
+				auto* first = data();
+				auto* target = first + (position - first);
+				std::move(target + 1, first + size_, target);
+				std::destroy_at(first + size_ - 1);
+				--size_;
+				return target;
+			}
+
+			auto erase(T const& value) -> size_type {
+				auto position = find(value);
+				if (position == end()) {
+					return 0;
+				}
+				erase(position);
+				return 1;
+			}
+
+			// Like std::set::merge: moves over every value of `other` that this set doesn't hold, and
+			// leaves the rest in `other`.
+			auto merge(small_flat_set& other) -> void {
+				if (other.empty()) {
+					return;
+				}
+				auto merged = small_flat_set(alloc_);
+				merged.reserve(size_ + other.size_);
+				auto left = small_flat_set(other.alloc_);
+				auto* a = data();
+				auto* a_last = a + size_;
+				auto* b = other.data();
+				auto* b_last = b + other.size_;
+				while (a != a_last or b != b_last) {
+					if (b == b_last or (a != a_last and *a < *b)) {
+						merged.push_back(std::move(*a++));
+					}
+					else if (a == a_last or *b < *a) {
+						merged.push_back(std::move(*b++));
+					}
+					else {
+						merged.push_back(std::move(*a++));
+						left.push_back(std::move(*b++));
+					}
+				}
+				*this = std::move(merged);
+				other = std::move(left);
+			}
+
+			auto clear() noexcept -> void {
+				std::destroy(data(), data() + size_);
+				size_ = 0;
+			}
+
+		private:
+			// The inline slots are in use while capacity_ == Inline; any larger capacity is on heap_.
+			union {
+				T inline_[Inline];
+				T* heap_;
+			};
+			// 32 bits is plenty for the parallel edges of one pair, and keeps a set with a few small
+			// weights inline down to four words.
+			std::uint32_t size_ = 0;
+			std::uint32_t capacity_ = Inline;
+			allocator_type alloc_;
+
+			[[nodiscard]] auto is_inline() const noexcept -> bool {
+				return capacity_ == Inline;
+			}
+
+			[[nodiscard]] auto data() noexcept -> T* {
+				return is_inline() ? inline_ : heap_;
+			}
+
+			[[nodiscard]] auto data() const noexcept -> T const* {
+				return is_inline() ? inline_ : heap_;
+			}
+
+			auto reserve(std::size_t capacity) -> void {
+				if (capacity <= capacity_) {
+					return;
+				}
+				auto* buffer = alloc_.allocate(capacity);
+				auto* first = data();
+				std::uninitialized_move(first, first + size_, buffer);
+				std::destroy(first, first + size_);
+				if (!is_inline()) {
+					alloc_.deallocate(heap_, capacity_);
+				}
+				heap_ = buffer;
+				capacity_ = static_cast<std::uint32_t>(capacity);
+			}
+
+			auto push_back(T&& value) -> void {
+				reserve(size_ + 1 > capacity_ ? 2 * std::size_t{capacity_} : capacity_);
+				std::construct_at(data() + size_, std::move(value));
+				++size_;
+			}
+
+			auto insert_at(const_iterator position, T const& value) -> iterator {
+				auto const index = static_cast<std::size_t>(position - data());
+				if (size_ == capacity_) {
+					reserve(2 * std::size_t{capacity_});
+				}
+				auto* first = data();
+				if (index == size_) {
+					std::construct_at(first + size_, value);
+				}
+				else {
+					std::construct_at(first + size_, std::move(first[size_ - 1]));
+					std::move_backward(first + index, first + size_ - 1, first + size_);
+					first[index] = value;
+				}
+				++size_;
+				return first + index;
+			}
+
+			// Copies, or with move iterators moves, an already sorted run of values onto the end.
+			template<typename Iterator>
+			auto append(Iterator first, Iterator last) -> void {
+				reserve(size_ + static_cast<std::size_t>(last - first));
+				for (; first != last; ++first) {
+					std::construct_at(data() + size_, *first);
+					++size_;
+				}
+			}
+
+			// Takes over other's values; other must use an equal allocator.
+			auto steal(small_flat_set& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+			   -> void {
+				if (other.is_inline()) {
+					std::uninitialized_move(other.inline_, other.inline_ + other.size_, inline_);
+					std::destroy(other.inline_, other.inline_ + other.size_);
+				}
+				else {
+					heap_ = other.heap_;
+					capacity_ = other.capacity_;
+					other.capacity_ = Inline;
+				}
+				size_ = std::exchange(other.size_, 0);
+			}
+
+			// Destroys every value and returns any buffer, leaving the set empty and inline.
+			auto release() noexcept -> void {
+				clear();
+				if (!is_inline()) {
+					alloc_.deallocate(heap_, capacity_);
+					capacity_ = Inline;
+				}
+			}
+		};
+	} // namespace detail
+} // namespace gdwg
+
+#endif // GDWG_SMALL_FLAT_SET_HPP
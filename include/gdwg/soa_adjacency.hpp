@@ -0,0 +1,292 @@
+#ifndef GDWG_SOA_ADJACENCY_HPP
+#define GDWG_SOA_ADJACENCY_HPP
+
+#include "gdwg/simd_search.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+	namespace detail {
+		// Graphs whose nodes and weights are both plain numbers. Their adjacencies keep a
+		// structure-of-arrays copy of their destinations for vectorised lookups.
+		template<typename N, typename E>
+		concept soa_layout = simd_searchable<N> and simd_searchable<E>;
+
+		// The outgoing adjacency of a node with arithmetic values: a std::pmr::map keyed by node
+		// pointer, plus two parallel sorted columns once it holds `threshold` destinations or more.
+		// The first column has the destinations' values, so find() is a simd_lower_bound over
+		// contiguous numbers rather than a walk down the tree chasing a pointer at each level; the
+		// second has the map entry for each of them. Smaller adjacencies are searched through the
+		// tree, which at that size costs no more and needs no extra allocation.
+		//
+		// The map holds the entries, so iterators, node handles and the addresses of the weight
+		// sets behave exactly as they do for std::map. A destination's value is read when its
+		// entry leaves, so a node must not be renamed while it is still a key here.
+		template<typename N, typename V, typename Compare>
+		class soa_adjacency {
+			using map_type = std::pmr::map<N const*, V, Compare>;
+
+		public:
+			using key_type = typename map_type::key_type;
+			using mapped_type = typename map_type::mapped_type;
+			using value_type = typename map_type::value_type;
+			using size_type = typename map_type::size_type;
+			using difference_type = typename map_type::difference_type;
+			using allocator_type = typename map_type::allocator_type;
+			using iterator = typename map_type::iterator;
+			using const_iterator = typename map_type::const_iterator;
+			using node_type = typename map_type::node_type;
+			using insert_return_type = typename map_type::insert_return_type;
+
+			static constexpr auto threshold = size_type{16};
+
+			soa_adjacency() = default;
+
+			explicit soa_adjacency(allocator_type alloc)
+			: map_(alloc)
+			, values_(alloc)
+			, entries_(alloc) {}
+
+			soa_adjacency(soa_adjacency const& other)
+			: soa_adjacency(other, allocator_type()) {}
+
+			soa_adjacency(soa_adjacency const& other, allocator_type alloc)
+			: map_(other.map_, alloc)
+			, values_(alloc)
+			, entries_(alloc) {
+				rebuild();
+			}
+
+			// Moving a map keeps its iterators valid, so the columns can come along as they are.
+			soa_adjacency(soa_adjacency&& other) noexcept
+			: map_(std::move(other.map_))
+			, values_(std::move(other.values_))
+			, entries_(std::move(other.entries_)) {
+				other.clear();
+			}
+
+			soa_adjacency(soa_adjacency&& other, allocator_type alloc)
+			: map_(std::move(other.map_), alloc)
+			, values_(alloc)
+			, entries_(alloc) {
+				rebuild();
+				other.clear();
+			}
+
+			auto operator=(soa_adjacency const& other) -> soa_adjacency& {
+				if (this != &other) {
+					map_ = other.map_;
+					rebuild();
+				}
+				return *this;
+			}
+
+			auto operator=(soa_adjacency&& other) -> soa_adjacency& {
+				if (this != &other) {
+					map_ = std::move(other.map_);
+					rebuild();
+					other.clear();
+				}
+				return *this;
+			}
+
+			~soa_adjacency() = default;
+
+			[[nodiscard]] auto get_allocator() const noexcept -> allocator_type {
+				return map_.get_allocator();
+			}
+
+			[[nodiscard]] auto begin() noexcept -> iterator {
+				return map_.begin();
+			}
+			[[nodiscard]] auto begin() const noexcept -> const_iterator {
+				return map_.begin();
+			}
+			[[nodiscard]] auto end() noexcept -> iterator {
+				return map_.end();
+			}
+			[[nodiscard]] auto end() const noexcept -> const_iterator {
+				return map_.end();
+			}
+
+			[[nodiscard]] auto size() const noexcept -> size_type {
+				return map_.size();
+			}
+			[[nodiscard]] auto empty() const noexcept -> bool {
+				return map_.empty();
+			}
+
+			[[nodiscard]] auto find(key_type key) -> iterator {
+				if (values_.empty()) {
+					return map_.find(key);
+				}
+				auto const i = position(*key);
+				return i != values_.size() and not(*key < values_[i]) ? entries_[i] : map_.end();
+			}
+			[[nodiscard]] auto find(key_type key) const -> const_iterator {
+				return const_cast<soa_adjacency&>(*this).find(key);
+			}
+			[[nodiscard]] auto contains(key_type key) const -> bool {
+				return find(key) != end();
+			}
+
+			template<typename... Args>
+			auto try_emplace(key_type key, Args&&... args) -> std::pair<iterator, bool> {
+				make_room();
+				auto result = map_.try_emplace(key, std::forward<Args>(args)...);
+				if (result.second) {
+					inserted(result.first);
+				}
+				return result;
+			}
+			template<typename... Args>
+			auto try_emplace(const_iterator hint, key_type key, Args&&... args) -> iterator {
+				make_room();
+				auto const size = map_.size();
+				auto it = map_.try_emplace(hint, key, std::forward<Args>(args)...);
+				if (map_.size() != size) {
+					inserted(it);
+				}
+				return it;
+			}
+			auto operator[](key_type key) -> mapped_type& {
+				return try_emplace(key).first->second;
+			}
+			auto insert(node_type&& handle) -> insert_return_type {
+				make_room();
+				auto result = map_.insert(std::move(handle));
+				if (result.inserted) {
+					inserted(result.position);
+				}
+				return result;
+			}
+
+			auto erase(const_iterator pos) -> iterator {
+				erasing(pos);
+				return map_.erase(pos);
+			}
+			auto erase(iterator pos) -> iterator {
+				return erase(const_iterator(pos));
+			}
+			auto erase(const_iterator first, const_iterator last) -> iterator {
+				while (first != last) {
+					first = erase(first);
+				}
+				return map_.erase(last, last);
+			}
+			auto erase(key_type key) -> size_type {
+				auto it = find(key);
+				if (it == end()) {
+					return 0;
+				}
+				erase(it);
+				return 1;
+			}
+			template<typename Pred>
+			friend auto erase_if(soa_adjacency& adj, Pred pred) -> size_type {
+				auto const size = adj.size();
+				for (auto it = adj.begin(); it != adj.end();) {
+					it = pred(*it) ? adj.erase(it) : std::next(it);
+				}
+				return size - adj.size();
+			}
+
+			auto extract(const_iterator pos) -> node_type {
+				erasing(pos);
+				return map_.extract(pos);
+			}
+			auto extract(key_type key) -> node_type {
+				auto it = find(key);
+				return it == end() ? node_type() : extract(it);
+			}
+
+			auto clear() noexcept -> void {
+				map_.clear();
+				values_.clear();
+				entries_.clear();
+			}
+
+		private:
+			map_type map_;
+			// Sorted by value, and filled exactly when map_ holds at least `threshold` entries.
+			std::pmr::vector<N> values_;
+			std::pmr::vector<iterator> entries_;
+
+			[[nodiscard]] auto position(N const& value) const noexcept -> std::size_t {
+				auto const* first = values_.data();
+				return static_cast<std::size_t>(
+				   simd_lower_bound(first, first + values_.size(), value) - first);
+			}
+
+			// Reserves the columns' room for one more entry before it goes into map_, so keeping them
+			// in step afterwards cannot throw.
+			auto make_room() -> void {
+				if (map_.size() + 1 >= threshold and values_.capacity() <= map_.size()) {
+					auto const capacity = std::max(threshold, 2 * values_.capacity());
+					values_.reserve(capacity);
+					entries_.reserve(capacity);
+				}
+			}
+
+			// Called after `it` has gone into map_.
+			auto inserted(iterator it) -> void {
+				if (map_.size() < threshold) {
+					return;
+				}
+				if (map_.size() == threshold) {
+					rebuild();
+					return;
+				}
+				auto const i = static_cast<std::ptrdiff_t>(position(*it->first));
+				values_.insert(values_.begin() + i, *it->first);
+				entries_.insert(entries_.begin() + i, it);
+			}
+
+			// Called before `it` leaves map_, while its key can still be read.
+			auto erasing(const_iterator it) -> void {
+				if (map_.size() <= threshold) {
+					values_.clear();
+					entries_.clear();
+					return;
+				}
+				auto const i = static_cast<std::ptrdiff_t>(position(*it->first));
+				values_.erase(values_.begin() + i);
+				entries_.erase(entries_.begin() + i);
+			}
+
+			auto rebuild() -> void {
+				values_.clear();
+				entries_.clear();
+				if (map_.size() < threshold) {
+					return;
+				}
+				values_.reserve(map_.size());
+				entries_.reserve(map_.size());
+				for (auto it = map_.begin(); it != map_.end(); ++it) {
+					values_.push_back(*it->first);
+					entries_.push_back(it);
+				}
+			}
+		};
+
+		// The adjacency a graph with nodes N and weights E uses, mapping destinations to V.
+		template<typename N, typename E, typename V, typename Compare>
+		struct adjacency_layout {
+			using type = std::pmr::map<N const*, V, Compare>;
+		};
+
+		template<typename N, typename E, typename V, typename Compare>
+		requires soa_layout<N, E>
+		struct adjacency_layout<N, E, V, Compare> {
+			using type = soa_adjacency<N, V, Compare>;
+		};
+	} // namespace detail
+} // namespace gdwg
+
+#endif // GDWG_SOA_ADJACENCY_HPP
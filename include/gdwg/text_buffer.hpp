@@ -0,0 +1,95 @@
+#ifndef GDWG_TEXT_BUFFER_HPP
+#define GDWG_TEXT_BUFFER_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <fmt/format.h>
+#include <ios>
+#include <iterator>
+#include <locale>
+#include <ostream>
+#include <sstream>
+#include <string_view>
+#include <type_traits>
+
+namespace gdwg {
+	namespace detail {
+		// Types read with std::from_chars and written with fmt. bool and the character types are
+		// excluded because operator<< doesn't print them as numbers.
+		template<typename T>
+		concept charconv_readable =
+		   std::floating_point<T>
+		   or (std::integral<T> and not std::same_as<T, bool> and not std::same_as<T, char>
+		       and not std::same_as<T, signed char> and not std::same_as<T, unsigned char>);
+
+		// Collects text in memory exactly as operator<< would write it to `os`, so it can reach
+		// the stream in a few large writes. Numbers and strings are formatted with fmt while the
+		// stream's formatting state is the default, where both agree byte for byte; anything else
+		// goes through a private stream that copies the state of `os`.
+		class text_buffer {
+		public:
+			// Buffered text past which a writer should hand it to the stream.
+			static constexpr auto flush_size = std::size_t{1} << 16;
+
+			explicit text_buffer(std::ostream const& os)
+			: plain_(has_default_format(os)) {
+				fallback_.copyfmt(os);
+				fallback_.tie(nullptr);
+				fallback_.exceptions(std::ios_base::goodbit);
+			}
+
+			[[nodiscard]] static auto has_default_format(std::ostream const& os) -> bool {
+				auto const ignored = std::ios_base::skipws | std::ios_base::unitbuf;
+				return (os.flags() & ~ignored) == std::ios_base::dec and os.width() == 0
+				       and os.precision() == 6 and os.getloc() == std::locale::classic();
+			}
+
+			// Appends literal text, which operator<< writes unchanged whatever the stream's state.
+			auto append_text(std::string_view text) -> void {
+				buffer_.append(text.data(), text.data() + text.size());
+			}
+
+			template<typename T>
+			auto append_value(T const& value) -> void {
+				if constexpr (std::is_convertible_v<T const&, std::string_view>) {
+					if (plain_) {
+						append_text(value);
+						return;
+					}
+				}
+				else if constexpr (std::floating_point<T>) {
+					if (plain_) {
+						fmt::format_to(std::back_inserter(buffer_), "{:g}", value);
+						return;
+					}
+				}
+				else if constexpr (charconv_readable<T>) {
+					if (plain_) {
+						fmt::format_to(std::back_inserter(buffer_), "{}", value);
+						return;
+					}
+				}
+				fallback_.str({});
+				fallback_ << value;
+				append_text(fallback_.view());
+			}
+
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return buffer_.size();
+			}
+
+			// Writes out and forgets everything collected so far.
+			auto write_to(std::ostream& os) -> void {
+				os.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+				buffer_.clear();
+			}
+
+		private:
+			fmt::memory_buffer buffer_;
+			bool plain_;
+			std::ostringstream fallback_;
+		};
+	} // namespace detail
+} // namespace gdwg
+
+#endif // GDWG_TEXT_BUFFER_HPP
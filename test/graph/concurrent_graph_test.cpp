@@ -0,0 +1,73 @@
+#include "gdwg/concurrent_graph.hpp"
+
+#include "gdwg/graph.hpp"
+
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Concurrent Graph Tests") {
+	SECTION("Snapshots Are Isolated From Later Updates") {
+		auto shared =
+		   gdwg::concurrent_graph<std::string, int>(gdwg::graph<std::string, int>{"a", "b"});
+		auto before = shared.read();
+		// Holding a snapshot doesn't hold up a writer, even on the same thread.
+		shared.update([](auto& g) {
+			g.insert_edge("a", "b", 1);
+			g.insert_node("c");
+		});
+		auto after = shared.read();
+		CHECK(before.version() == 0);
+		CHECK(after.version() == 1);
+		CHECK(!before->is_connected("a", "b"));
+		CHECK(after->is_connected("a", "b"));
+		CHECK(before->nodes() == std::vector<std::string>{"a", "b"});
+		CHECK((*after).nodes() == std::vector<std::string>{"a", "b", "c"});
+	}
+
+	SECTION("A Throwing Batch Publishes Nothing") {
+		auto shared = gdwg::concurrent_graph<int, int>(gdwg::graph<int, int>{1, 2});
+		CHECK_THROWS(shared.update([](auto& g) {
+			g.insert_edge(1, 2, 3);
+			g.insert_edge(1, 4, 3);
+		}));
+		CHECK(shared.read().version() == 0);
+		CHECK(!shared.read()->is_connected(1, 2));
+
+		shared.replace(gdwg::graph<int, int>{7});
+		CHECK(shared.read()->is_node(7));
+		CHECK(shared.read().version() == 1);
+	}
+
+	SECTION("Readers See Only Whole Batches") {
+		auto shared = gdwg::concurrent_graph<int, int>(gdwg::graph<int, int>{0, 1});
+		auto done = std::atomic<bool>(false);
+		auto torn = std::atomic<int>(0);
+		auto readers = std::vector<std::thread>();
+		for (auto i = 0; i < 4; ++i) {
+			readers.emplace_back([&] {
+				while (!done.load()) {
+					auto const snapshot = shared.read();
+					// Every batch adds one weight to both directions.
+					if (snapshot->weights(0, 1).size() != snapshot->weights(1, 0).size()) {
+						++torn;
+					}
+				}
+			});
+		}
+		for (auto i = 0; i < 200; ++i) {
+			shared.update([i](auto& g) {
+				g.insert_edge(0, 1, i);
+				g.insert_edge(1, 0, i);
+			});
+		}
+		done = true;
+		for (auto& reader : readers) {
+			reader.join();
+		}
+		CHECK(torn.load() == 0);
+		CHECK(shared.read()->weights(0, 1).size() == 200);
+	}
+}
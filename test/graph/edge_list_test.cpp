@@ -0,0 +1,132 @@
+#include "gdwg/edge_list.hpp"
+
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+	auto write(std::string_view text, std::string const& name) -> std::filesystem::path {
+		auto path = std::filesystem::temp_directory_path() / name;
+		auto out = std::ofstream(path, std::ios::binary);
+		out << text;
+		return path;
+	}
+} // namespace
+
+TEST_CASE("Edge List Loading Tests") {
+	auto const values = std::vector<gdwg::graph<std::string, int>::value_type>{
+	   {"hello", "are", 8},
+	   {"hello", "are", 2},
+	   {"how", "you?", 1},
+	   {"how", "hello", 4},
+	   {"are", "you?", 3},
+	};
+	auto expected = gdwg::graph<std::string, int>(values.begin(), values.end());
+	expected.insert_node("alone");
+
+	SECTION("Every Format") {
+		auto const whitespace = std::string_view("# a comment\n"
+		                                         "hello are 8\n"
+		                                         "  hello\tare   2  \n"
+		                                         "\n"
+		                                         "how you? 1\r\n"
+		                                         "how hello 4\n"
+		                                         "alone\n"
+		                                         "are you? 3\n"
+		                                         "hello are 8");
+		auto const path = write(whitespace, "gdwg_edge_list.txt");
+		CHECK(gdwg::load_edge_list<std::string, int>(path) == expected);
+
+		auto const csv = std::string_view("src,dst,weight\n"
+		                                  "hello,are,8\n"
+		                                  "hello,are,2\n"
+		                                  "how,you?,1\n"
+		                                  "how,hello,4\n"
+		                                  "alone\n"
+		                                  "are,you?,3\n");
+		auto options = gdwg::edge_list_options();
+		options.format = gdwg::edge_list_format::csv;
+		options.header = true;
+		write(csv, "gdwg_edge_list.txt");
+		CHECK(gdwg::load_edge_list<std::string, int>(path, options) == expected);
+
+		auto const tsv = std::string_view("hello\tare\t8\n"
+		                                  "hello\tare\t2\n"
+		                                  "how\tyou?\t1\n"
+		                                  "how\thello\t4\n"
+		                                  "alone\n"
+		                                  "are\tyou?\t3\n");
+		options.format = gdwg::edge_list_format::tsv;
+		options.header = false;
+		write(tsv, "gdwg_edge_list.txt");
+		CHECK(gdwg::load_edge_list<std::string, int>(path, options) == expected);
+
+		write("", "gdwg_edge_list.txt");
+		CHECK(gdwg::load_edge_list<int, double>(path).empty());
+		std::filesystem::remove(path);
+	}
+
+	SECTION("Any Split Gives The Same Graph") {
+		auto engine = std::mt19937(17);
+		auto node = std::uniform_int_distribution<int>(-50, 50);
+		auto text = std::ostringstream();
+		auto reference = gdwg::graph<int, double>();
+		for (auto i = 0; i < 2000; ++i) {
+			auto const from = node(engine);
+			auto const to = node(engine);
+			auto const weight = node(engine) / 4.0;
+			text << from << ' ' << to << ' ' << weight << '\n';
+			reference.insert_node(from);
+			reference.insert_node(to);
+			reference.insert_edge(from, to, weight);
+		}
+		auto const input = text.str();
+		auto options = gdwg::edge_list_options();
+		for (auto const chunks : std::vector<std::size_t>{1, 2, 3, 8, 61}) {
+			CHECK(gdwg::detail::parse_edge_list<int, double>(input, options, chunks) == reference);
+		}
+		auto const path = write(input, "gdwg_edge_list_large.txt");
+		options.threads = 4;
+		options.storage = gdwg::graph_storage::arena;
+		CHECK(gdwg::load_edge_list<int, double>(path, options) == reference);
+		std::filesystem::remove(path);
+	}
+
+	SECTION("Rejected Input") {
+		auto const options = gdwg::edge_list_options();
+		auto parse = [&options](std::string_view text, std::size_t chunks) {
+			return gdwg::detail::parse_edge_list<int, int>(text, options, chunks);
+		};
+		auto const good = std::string("1 2 3\n4 5 6\n7 8 9\n");
+		for (auto chunks : {std::size_t{1}, std::size_t{4}}) {
+			CHECK_THROWS_WITH(parse(good + "1 2\n" + good, chunks),
+			                  "Cannot load a gdwg::graph<N, E> edge list from line 4: expected 'src "
+			                  "dst weight' or a lone node");
+			CHECK_THROWS_WITH(parse(good + good + "1 x 3\n1 2\n", chunks),
+			                  "Cannot load a gdwg::graph<N, E> edge list from line 7: the destination "
+			                  "node can't be parsed");
+			CHECK_THROWS_WITH(parse(good + "1 2 3.5", chunks),
+			                  "Cannot load a gdwg::graph<N, E> edge list from line 4: the weight can't "
+			                  "be parsed");
+			CHECK_THROWS_WITH(parse("1 2 3 4", chunks),
+			                  "Cannot load a gdwg::graph<N, E> edge list from line 1: expected 'src "
+			                  "dst weight' or a lone node");
+		}
+		auto csv = options;
+		csv.format = gdwg::edge_list_format::csv;
+		CHECK_THROWS_WITH((gdwg::detail::parse_edge_list<int, int>("1, 2,3\n", csv, 1)),
+		                  "Cannot load a gdwg::graph<N, E> edge list from line 1: the destination "
+		                  "node can't be parsed");
+		auto const missing = std::filesystem::temp_directory_path() / "gdwg_edge_list_missing.txt";
+		CHECK_THROWS_WITH((gdwg::load_edge_list<int, int>(missing)),
+		                  "Cannot call gdwg::load_edge_list on a file that can't be opened");
+	}
+}
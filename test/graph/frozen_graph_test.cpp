@@ -0,0 +1,88 @@
+#include "gdwg/frozen_graph.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+TEST_CASE("Frozen Graph Tests") {
+	auto const values = std::vector<gdwg::graph<std::string, int>::value_type>{
+	   {"hello", "are", 8},
+	   {"hello", "are", 2},
+	   {"how", "you?", 1},
+	   {"how", "hello", 4},
+	   {"are", "you?", 3},
+	   {"are", "are", -1},
+	};
+	auto g = gdwg::graph<std::string, int>(values.begin(), values.end());
+	g.insert_node("lonely");
+	auto const frozen = gdwg::frozen_graph(g);
+
+	SECTION("Accessors Match The Source Graph") {
+		CHECK(frozen.nodes() == g.nodes());
+		CHECK(frozen.is_node("lonely"));
+		CHECK(!frozen.is_node(std::string_view("nobody")));
+		CHECK(frozen.is_connected("hello", "are"));
+		CHECK(!frozen.is_connected("are", "hello"));
+		CHECK(frozen.weights("hello", "are") == std::vector<int>{2, 8});
+		CHECK(frozen.weights("lonely", "are").empty());
+		CHECK(frozen.connections("how") == std::vector<std::string>{"hello", "you?"});
+		CHECK(frozen.connections("are") == std::vector<std::string>{"are", "you?"});
+		CHECK(frozen.connections("lonely").empty());
+		CHECK_THROWS_WITH(frozen.connections("UNSW"),
+		                  "Cannot call gdwg::frozen_graph<N, E>::connections if src doesn't exist in "
+		                  "the graph");
+		CHECK_THROWS_WITH(frozen.weights("john", "smit"),
+		                  "Cannot call gdwg::frozen_graph<N, E>::weights if src or dst node don't "
+		                  "exist in the graph");
+	}
+
+	SECTION("Iteration Matches The Source Graph") {
+		auto expected = std::vector<ranges::common_tuple<std::string, std::string, int>>();
+		for (auto const& [from, to, weight] : g) {
+			expected.emplace_back(from, to, weight);
+		}
+		std::sort(expected.begin(), expected.end());
+		auto actual = std::vector<ranges::common_tuple<std::string, std::string, int>>();
+		for (auto const& [from, to, weight] : frozen) {
+			actual.emplace_back(from, to, weight);
+		}
+		CHECK(actual == expected);
+
+		auto backward = std::vector<ranges::common_tuple<std::string, std::string, int>>();
+		for (auto it = frozen.end(); it != frozen.begin();) {
+			--it;
+			backward.emplace_back(*it);
+		}
+		std::reverse(backward.begin(), backward.end());
+		CHECK(backward == expected);
+	}
+
+	SECTION("Find") {
+		auto it = frozen.find("hello", "are", 8);
+		REQUIRE(it != frozen.end());
+		CHECK(*it == ranges::common_tuple<std::string, std::string, int>{"hello", "are", 8});
+		++it;
+		CHECK(*it == ranges::common_tuple<std::string, std::string, int>{"how", "hello", 4});
+		CHECK(frozen.find("hello", "are", 3) == frozen.end());
+		CHECK(frozen.find("Danny", "Johnson", 9) == frozen.end());
+	}
+
+	SECTION("Output And Thaw") {
+		auto expected = std::ostringstream{};
+		expected << g;
+		auto actual = std::ostringstream{};
+		actual << frozen;
+		CHECK(actual.str() == expected.str());
+		CHECK(frozen.thaw() == g);
+	}
+
+	SECTION("Empty Graph") {
+		auto const empty = gdwg::frozen_graph(gdwg::graph<int, int>());
+		CHECK(empty.empty());
+		CHECK(empty.begin() == empty.end());
+	}
+}
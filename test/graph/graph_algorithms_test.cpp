@@ -0,0 +1,174 @@
+#include "gdwg/graph_algorithms.hpp"
+
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+TEST_CASE("Graph Algorithm Tests") {
+	// Two strongly connected triangles joined one way, a tail off the second, and an isolated
+	// node.
+	auto const value_type_vector = std::vector<gdwg::graph<int, int>::value_type>{
+	   {1, 2, 1},
+	   {2, 3, 1},
+	   {3, 1, 1},
+	   {3, 4, 1},
+	   {3, 4, 2},
+	   {4, 5, 1},
+	   {5, 6, 1},
+	   {6, 4, 1},
+	   {6, 7, 1},
+	};
+	auto g = gdwg::graph<int, int>(value_type_vector.begin(), value_type_vector.end());
+	g.insert_node(8);
+
+	SECTION("Breadth-First Search") {
+		CHECK(gdwg::bfs(g, 1) == std::vector<int>{1, 2, 3, 4, 5, 6, 7});
+		CHECK(gdwg::bfs(g, 6) == std::vector<int>{6, 4, 7, 5});
+		CHECK(gdwg::bfs(g, 8) == std::vector<int>{8});
+		CHECK(gdwg::parallel_bfs(g, 6) == std::vector<int>{6, 4, 7, 5});
+
+		auto fan = gdwg::graph<int, int>{1, 2, 3, 4, 5};
+		fan.insert_edge(1, 3, 0);
+		fan.insert_edge(1, 2, 0);
+		fan.insert_edge(3, 4, 0);
+		fan.insert_edge(2, 5, 0);
+		CHECK(gdwg::bfs(fan, 1) == std::vector<int>{1, 2, 3, 5, 4});
+		CHECK(gdwg::parallel_bfs(fan, 1) == std::vector<int>{1, 2, 3, 4, 5});
+	}
+
+	SECTION("Depth-First Search") {
+		CHECK(gdwg::dfs(g, 1) == std::vector<int>{1, 2, 3, 4, 5, 6, 7});
+		CHECK(gdwg::dfs(g, 6) == std::vector<int>{6, 4, 5, 7});
+
+		auto fan = gdwg::graph<int, int>{1, 2, 3, 4, 5};
+		fan.insert_edge(1, 3, 0);
+		fan.insert_edge(1, 2, 0);
+		fan.insert_edge(3, 4, 0);
+		fan.insert_edge(2, 5, 0);
+		CHECK(gdwg::dfs(fan, 1) == std::vector<int>{1, 2, 5, 3, 4});
+	}
+
+	SECTION("A Long Chain Doesn't Recurse") {
+		auto chain = gdwg::graph<int, int>();
+		for (auto i = 0; i < 200000; ++i) {
+			chain.insert_node(i);
+		}
+		for (auto i = 1; i < 200000; ++i) {
+			chain.insert_edge(i - 1, i, 0);
+		}
+		CHECK(gdwg::dfs(chain, 0).size() == 200000);
+		CHECK(gdwg::strongly_connected_components(chain).size() == 200000);
+		chain.insert_edge(199999, 0, 0);
+		CHECK(gdwg::strongly_connected_components(chain).size() == 1);
+	}
+
+	SECTION("Missing Sources") {
+		CHECK_THROWS_WITH(gdwg::bfs(g, 9), "Cannot call gdwg::bfs if src doesn't exist in the graph");
+		CHECK_THROWS_WITH(gdwg::parallel_bfs(g, 9),
+		                  "Cannot call gdwg::parallel_bfs if src doesn't exist in the graph");
+		CHECK_THROWS_WITH(gdwg::dfs(g, 9), "Cannot call gdwg::dfs if src doesn't exist in the graph");
+	}
+
+	SECTION("Weakly Connected Components") {
+		auto const expected = std::vector<std::vector<int>>{{1, 2, 3, 4, 5, 6, 7}, {8}};
+		CHECK(gdwg::weakly_connected_components(g) == expected);
+		CHECK(gdwg::parallel_weakly_connected_components(g) == expected);
+
+		auto split = gdwg::graph<int, int>{1, 2, 3, 4, 5};
+		split.insert_edge(5, 1, 0);
+		split.insert_edge(4, 2, 0);
+		split.insert_edge(3, 2, 0);
+		auto const pieces = std::vector<std::vector<int>>{{1, 5}, {2, 3, 4}};
+		CHECK(gdwg::weakly_connected_components(split) == pieces);
+		CHECK(gdwg::parallel_weakly_connected_components(split) == pieces);
+		CHECK(gdwg::weakly_connected_components(gdwg::graph<int, int>()).empty());
+	}
+
+	SECTION("Strongly Connected Components") {
+		// Sinks first: no component has an edge to a later one.
+		CHECK(gdwg::strongly_connected_components(g)
+		      == std::vector<std::vector<int>>{{7}, {4, 5, 6}, {1, 2, 3}, {8}});
+
+		auto loop = gdwg::graph<int, int>{1, 2};
+		loop.insert_edge(1, 1, 0);
+		loop.insert_edge(1, 2, 0);
+		CHECK(gdwg::strongly_connected_components(loop) == std::vector<std::vector<int>>{{2}, {1}});
+	}
+
+	SECTION("Topological Sort") {
+		CHECK_THROWS_WITH(gdwg::topological_sort(g),
+		                  "Cannot call gdwg::topological_sort on a graph with a cycle");
+
+		auto dag = gdwg::graph<std::string, int>{"shirt", "tie", "jacket", "belt", "trousers"};
+		dag.insert_edge("shirt", "tie", 0);
+		dag.insert_edge("tie", "jacket", 0);
+		dag.insert_edge("shirt", "belt", 0);
+		dag.insert_edge("belt", "jacket", 0);
+		dag.insert_edge("trousers", "belt", 0);
+		dag.insert_edge("trousers", "belt", 1);
+		CHECK(gdwg::topological_sort(dag)
+		      == std::vector<std::string>{"shirt", "trousers", "tie", "belt", "jacket"});
+		CHECK(gdwg::bfs(dag, std::string_view("shirt"))
+		      == std::vector<std::string>{"shirt", "belt", "tie", "jacket"});
+
+		dag.insert_edge("jacket", "jacket", 0);
+		CHECK_THROWS_WITH(gdwg::topological_sort(dag),
+		                  "Cannot call gdwg::topological_sort on a graph with a cycle");
+	}
+
+	SECTION("Serial And Parallel Agree On A Large Graph") {
+		auto engine = std::mt19937(4127);
+		auto node = std::uniform_int_distribution<int>(0, 19999);
+		auto values = std::vector<gdwg::graph<int, int>::value_type>();
+		for (auto i = 0; i < 60000; ++i) {
+			values.push_back({node(engine), node(engine), 0});
+		}
+		auto const large = gdwg::graph<int, int>(values.begin(), values.end());
+		auto const source = values.front().from;
+
+		auto const serial = gdwg::bfs(large, source);
+		auto const parallel = gdwg::parallel_bfs(large, source);
+		CHECK(serial.size() > 4000);
+		// Both visit the same nodes level by level; only the order within a level differs.
+		auto level = std::map<int, int>{{source, 0}};
+		for (auto const from : serial) {
+			for (auto const& to : large.connections(from)) {
+				level.try_emplace(to, level.at(from) + 1);
+			}
+		}
+		REQUIRE(parallel.size() == serial.size());
+		for (auto i = std::size_t{1}; i < parallel.size(); ++i) {
+			auto const a = level.at(parallel[i - 1]);
+			auto const b = level.at(parallel[i]);
+			CHECK((a < b or (a == b and parallel[i - 1] < parallel[i])));
+		}
+
+		auto const components = gdwg::weakly_connected_components(large);
+		CHECK(gdwg::parallel_weakly_connected_components(large) == components);
+		auto total = std::size_t{0};
+		for (auto const& component : components) {
+			CHECK(std::is_sorted(component.begin(), component.end()));
+			total += component.size();
+		}
+		CHECK(total == large.nodes().size());
+
+		// Every edge stays within one strongly connected component or leads to an earlier one.
+		auto const strong = gdwg::strongly_connected_components(large);
+		auto position = std::map<int, std::size_t>();
+		for (auto i = std::size_t{0}; i < strong.size(); ++i) {
+			for (auto const n : strong[i]) {
+				position.emplace(n, i);
+			}
+		}
+		CHECK(position.size() == large.nodes().size());
+		for (auto const& [from, to, weight] : large) {
+			CHECK(position.at(to) <= position.at(from));
+		}
+	}
+}
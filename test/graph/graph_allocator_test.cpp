@@ -0,0 +1,137 @@
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace {
+	// Forwards to new/delete and counts how many blocks were requested.
+	class counting_resource : public std::pmr::memory_resource {
+	public:
+		std::size_t allocations = 0;
+
+	private:
+		auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override {
+			++allocations;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+		auto do_deallocate(void* p, std::size_t bytes, std::size_t alignment) -> void override {
+			std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+		}
+		[[nodiscard]] auto do_is_equal(std::pmr::memory_resource const& other) const noexcept
+		   -> bool override {
+			return this == &other;
+		}
+	};
+
+	constexpr auto node_count = 100;
+	constexpr auto edge_count = node_count * node_count;
+
+	auto fill(gdwg::graph<int, int>& g) -> void {
+		for (auto i = 0; i < node_count; ++i) {
+			g.insert_node(i);
+		}
+		for (auto i = 0; i < node_count; ++i) {
+			for (auto j = 0; j < node_count; ++j) {
+				g.insert_edge(i, j, i * j);
+			}
+		}
+	}
+
+	// Counts the upstream allocations made while building a graph with the given storage mode.
+	auto allocations_for(gdwg::graph_storage storage) -> std::size_t {
+		auto counter = counting_resource();
+		auto* previous = std::pmr::set_default_resource(&counter);
+		{
+			auto g = gdwg::graph<int, int>(storage);
+			fill(g);
+			CHECK(g.storage() == storage);
+			CHECK(g.weights(3, 4) == std::vector<int>{12});
+		}
+		std::pmr::set_default_resource(previous);
+		return counter.allocations;
+	}
+} // namespace
+
+TEST_CASE("Allocator Aware Graph Tests") {
+	SECTION("Caller Supplied Resource") {
+		auto counter = counting_resource();
+		auto g = gdwg::graph<int, int>(&counter);
+		CHECK(g.resource() == &counter);
+		fill(g);
+		// A single weight is stored inline in its adjacency node, so an edge costs that one node;
+		// each node adds its own tree node and the tree node of its adjacency. An adjacency of int
+		// nodes also keeps two columns, which double from 16 entries to 128 to hold 100.
+		constexpr auto column_allocations = 2 * 4;
+		CHECK(counter.allocations <= edge_count + (2 + column_allocations) * node_count);
+		CHECK(counter.allocations >= edge_count);
+	}
+
+	SECTION("Arena And Pool Allocate Far Less Per Edge") {
+		auto const heap = allocations_for(gdwg::graph_storage::heap);
+		auto const arena = allocations_for(gdwg::graph_storage::arena);
+		auto const pool = allocations_for(gdwg::graph_storage::pool);
+		CHECK(heap >= edge_count);
+		CHECK(arena * 100 < edge_count);
+		CHECK(pool * 10 < edge_count);
+	}
+
+	SECTION("Arena Clear Releases Everything And Stays Usable") {
+		auto g = gdwg::graph<int, int>(gdwg::graph_storage::arena);
+		fill(g);
+		g.clear();
+		CHECK(g.empty());
+		CHECK(g.begin() == g.end());
+		fill(g);
+		CHECK(g.connections(7).size() == node_count);
+
+		auto strings = gdwg::graph<std::string, int>(gdwg::graph_storage::arena);
+		strings.insert_node("a long enough string to defeat the small string optimisation");
+		strings.insert_node("b");
+		strings.insert_edge("b", "a long enough string to defeat the small string optimisation", 1);
+		strings.clear();
+		CHECK(strings.empty());
+	}
+
+	SECTION("Indexed Arena Graphs Are Released Whole") {
+		using graph = gdwg::graph<int, int>;
+		auto g = graph(gdwg::incoming_index, gdwg::weight_index, gdwg::graph_storage::arena);
+		fill(g);
+		auto other = graph(gdwg::incoming_index, gdwg::weight_index, gdwg::graph_storage::arena);
+		fill(other);
+		other.erase_node(0);
+		g = std::move(other);
+		CHECK(g.has_incoming_index());
+		CHECK(g.has_weight_index());
+		CHECK(g.in_degree(7) == node_count - 1);
+		CHECK(!g.is_node(0));
+		auto scoped = graph(gdwg::incoming_index, gdwg::weight_index, gdwg::graph_storage::arena);
+		fill(scoped);
+	}
+
+	SECTION("Copy And Move Keep Storage Valid") {
+		auto arena = gdwg::graph<int, int>(gdwg::graph_storage::pool);
+		fill(arena);
+		auto copy = arena;
+		CHECK(copy.storage() == gdwg::graph_storage::pool);
+		CHECK(copy.resource() != arena.resource());
+		CHECK(copy == arena);
+
+		auto moved = std::move(arena);
+		CHECK(moved == copy);
+		CHECK(arena.empty());
+		CHECK(arena.storage() == gdwg::graph_storage::heap);
+		arena.insert_node(1);
+		CHECK(arena.is_node(1));
+
+		auto target = gdwg::graph<int, int>(gdwg::graph_storage::arena);
+		target.insert_node(42);
+		target = std::move(moved);
+		CHECK(target == copy);
+		CHECK(target.storage() == gdwg::graph_storage::pool);
+		target = copy;
+		CHECK(target == copy);
+	}
+}
@@ -0,0 +1,134 @@
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+	using graph = gdwg::graph<int, int>;
+	using mutation = graph::mutation;
+
+	// What apply() has to match: each operation as a separate call.
+	auto apply_sequentially(graph& g, std::vector<mutation> const& batch) -> std::vector<bool> {
+		auto results = std::vector<bool>();
+		for (auto const& op : batch) {
+			switch (op.op) {
+			case mutation::kind::insert_node: results.push_back(g.insert_node(op.src)); break;
+			case mutation::kind::erase_node: results.push_back(g.erase_node(op.src)); break;
+			case mutation::kind::insert_edge:
+				results.push_back(g.insert_edge(op.src, op.dst, op.weight));
+				break;
+			case mutation::kind::erase_edge:
+				results.push_back(g.erase_edge(op.src, op.dst, op.weight));
+				break;
+			}
+		}
+		return results;
+	}
+} // namespace
+
+TEST_CASE("Batched Mutation Tests") {
+	auto g = graph{1, 2, 3};
+	g.insert_edge(1, 2, 5);
+	g.insert_edge(2, 3, 1);
+
+	SECTION("Results Match Separate Calls") {
+		auto const batch = std::vector<mutation>{
+		   mutation::insert_node(4),
+		   mutation::insert_node(1),
+		   mutation::insert_edge(1, 4, 7),
+		   mutation::insert_edge(1, 2, 5),
+		   mutation::erase_edge(2, 3, 1),
+		   mutation::erase_edge(2, 3, 1),
+		   mutation::insert_edge(4, 4, 0),
+		};
+		CHECK(g.apply(batch) == std::vector<bool>{true, false, true, false, true, false, true});
+
+		auto expected = graph{1, 2, 3, 4};
+		expected.insert_edge(1, 2, 5);
+		expected.insert_edge(1, 4, 7);
+		expected.insert_edge(4, 4, 0);
+		CHECK(g == expected);
+	}
+
+	SECTION("Erasing A Node Drops Its Edges Until It Returns") {
+		auto const batch = std::vector<mutation>{
+		   mutation::insert_edge(3, 2, 9),
+		   mutation::erase_node(2),
+		   mutation::insert_node(2),
+		   mutation::insert_edge(1, 2, 5),
+		   mutation::erase_node(3),
+		};
+		CHECK(g.apply(batch) == std::vector<bool>{true, true, true, true, true});
+
+		auto expected = graph{1, 2};
+		expected.insert_edge(1, 2, 5);
+		CHECK(g == expected);
+	}
+
+	SECTION("A Throwing Operation Keeps The Ones Before It") {
+		auto const batch = std::vector<mutation>{
+		   mutation::insert_edge(3, 1, 2),
+		   mutation::erase_node(1),
+		   mutation::erase_edge(3, 1, 2),
+		   mutation::insert_node(9),
+		};
+		CHECK_THROWS_WITH(g.apply(batch),
+		                  "Cannot call gdwg::graph<N, E>::erase_edge on src or dst if they don't "
+		                  "exist in the graph");
+
+		auto expected = graph{2, 3};
+		expected.insert_edge(2, 3, 1);
+		CHECK(g == expected);
+		CHECK_THROWS_WITH(g.apply(std::vector{mutation::insert_edge(2, 7, 0)}),
+		                  "Cannot call gdwg::graph<N, E>::insert_edge when either src or dst node "
+		                  "does not exist");
+		CHECK(g == expected);
+	}
+
+	SECTION("Random Batches Match Separate Calls") {
+		auto engine = std::mt19937(7);
+		auto value = std::uniform_int_distribution<int>(0, 7);
+		auto kind = std::uniform_int_distribution<int>(0, 9);
+		for (auto round = 0; round < 200; ++round) {
+			auto batch = std::vector<mutation>();
+			for (auto i = 0; i < 40; ++i) {
+				auto const k = kind(engine);
+				auto const src = value(engine);
+				auto const dst = value(engine);
+				auto const weight = value(engine) % 3;
+				if (k < 2) {
+					batch.push_back(mutation::insert_node(src));
+				}
+				else if (k < 3) {
+					batch.push_back(mutation::erase_node(src));
+				}
+				else if (k < 7) {
+					batch.push_back(mutation::insert_edge(src, dst, weight));
+				}
+				else {
+					batch.push_back(mutation::erase_edge(src, dst, weight));
+				}
+			}
+
+			auto expected = g;
+			auto expected_results = std::vector<bool>();
+			auto threw = false;
+			try {
+				expected_results = apply_sequentially(expected, batch);
+			} catch (std::runtime_error const&) {
+				threw = true;
+			}
+
+			if (threw) {
+				CHECK_THROWS_AS(g.apply(batch), std::runtime_error);
+			}
+			else {
+				CHECK(g.apply(batch) == expected_results);
+			}
+			REQUIRE(g == expected);
+		}
+	}
+}
@@ -0,0 +1,144 @@
+#include "gdwg/graph_binary.hpp"
+
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+	template<typename N, typename E>
+	auto save(gdwg::graph<N, E> const& g, std::string const& name) -> std::filesystem::path {
+		auto path = std::filesystem::temp_directory_path() / name;
+		auto out = std::ofstream(path, std::ios::binary);
+		gdwg::save_binary(g, out);
+		return path;
+	}
+} // namespace
+
+TEST_CASE("Binary Serialization Tests") {
+	auto const values = std::vector<gdwg::graph<std::string, int>::value_type>{
+	   {"hello", "are", 8},
+	   {"hello", "are", 2},
+	   {"how", "you?", 1},
+	   {"how", "hello", 4},
+	   {"are", "you?", 3},
+	};
+	auto g = gdwg::graph<std::string, int>(values.begin(), values.end());
+	g.insert_node("alone");
+
+	SECTION("String Pool Round Trip") {
+		auto const path = save(g, "gdwg_binary_strings.bin");
+		auto const mapped = gdwg::mapped_graph<std::string, int>(path);
+		CHECK(mapped.nodes() == g.nodes());
+		CHECK(mapped.is_node("alone"));
+		CHECK(!mapped.is_node("hi"));
+		CHECK(mapped.is_connected("hello", "are"));
+		CHECK(!mapped.is_connected("are", "hello"));
+		CHECK(mapped.weights("hello", "are") == std::vector<int>{2, 8});
+		CHECK(mapped.connections("how") == std::vector<std::string>{"hello", "you?"});
+		CHECK(mapped.connections("alone").empty());
+		CHECK(mapped.find("how", "hello", 4) != mapped.end());
+		CHECK(mapped.find("how", "hello", 5) == mapped.end());
+
+		auto it = mapped.begin();
+		auto const& [from, to, weight] = *it;
+		CHECK(from == std::string_view("are"));
+		CHECK(to == std::string_view("you?"));
+		CHECK(weight == 3);
+		CHECK(std::distance(mapped.begin(), mapped.end()) == 5);
+		auto last = mapped.end();
+		--last;
+		CHECK(std::get<1>(*last) == std::string_view("you?"));
+		CHECK(mapped.thaw() == g);
+		std::filesystem::remove(path);
+	}
+
+	SECTION("Raw Block Round Trip") {
+		auto numbers = gdwg::graph<int, double>{1, 2, 3, 4, 5};
+		numbers.insert_edge(4, 1, -4.5);
+		numbers.insert_edge(2, 2, 0.25);
+		numbers.insert_edge(2, 1, 1.0);
+		numbers.insert_edge(2, 1, -1.0);
+		auto const path = save(numbers, "gdwg_binary_numbers.bin");
+		auto const mapped = gdwg::mapped_graph<int, double>(path);
+		CHECK(mapped.thaw() == numbers);
+		CHECK(mapped.weights(2, 1) == std::vector<double>{-1.0, 1.0});
+		CHECK(&std::get<0>(*mapped.begin()) == &std::get<0>(*std::next(mapped.begin())));
+		std::filesystem::remove(path);
+	}
+
+	SECTION("Empty Graphs") {
+		auto const path = save(gdwg::graph<int, int>(), "gdwg_binary_empty.bin");
+		auto const mapped = gdwg::mapped_graph<int, int>(path);
+		CHECK(mapped.empty());
+		CHECK(mapped.begin() == mapped.end());
+		CHECK(mapped.thaw() == gdwg::graph<int, int>());
+
+		auto const nodes_only = gdwg::graph<int, int>{3, 1, 2};
+		auto const nodes_path = save(nodes_only, "gdwg_binary_nodes.bin");
+		CHECK(gdwg::mapped_graph<int, int>(nodes_path).thaw() == nodes_only);
+		std::filesystem::remove(path);
+		std::filesystem::remove(nodes_path);
+	}
+
+	SECTION("Rejected Files") {
+		auto const path = save(g, "gdwg_binary_rejected.bin");
+		CHECK_THROWS_WITH((gdwg::mapped_graph<std::string, double>(path)),
+		                  "Cannot call gdwg::mapped_graph<N, E>::mapped_graph on a file written for "
+		                  "different node or weight types");
+		std::filesystem::resize_file(path, std::filesystem::file_size(path) - 20);
+		CHECK_THROWS_WITH((gdwg::mapped_graph<std::string, int>(path)),
+		                  "Cannot call gdwg::mapped_graph<N, E>::mapped_graph on a truncated file");
+		{
+			auto out = std::ofstream(path, std::ios::binary);
+			out << g;
+		}
+		CHECK_THROWS_WITH((gdwg::mapped_graph<std::string, int>(path)),
+		                  "Cannot call gdwg::mapped_graph<N, E>::mapped_graph on a file that isn't a "
+		                  "gdwg::graph binary");
+		std::filesystem::remove(path);
+		CHECK_THROWS_WITH((gdwg::mapped_graph<std::string, int>(path)),
+		                  "Cannot call gdwg::mapped_graph<N, E>::mapped_graph on a file that can't "
+		                  "be opened");
+	}
+
+	SECTION("Rejected Files With Bad Offsets") {
+		auto numbers = gdwg::graph<int, int>{1, 2, 3, 4, 5};
+		numbers.insert_edge(4, 1, 7);
+		numbers.insert_edge(2, 2, 8);
+		numbers.insert_edge(2, 1, 9);
+		// A 48 byte header, 5 ints padded to 32 bytes, then pair offsets, then pair dsts.
+		auto const pair_offsets = std::streamoff{80};
+		auto const pair_dsts = std::streamoff{128};
+		for (auto const position : {pair_offsets + 8, pair_offsets + 40, pair_dsts, pair_dsts + 16}) {
+			auto const path = save(numbers, "gdwg_binary_offsets.bin");
+			REQUIRE(gdwg::mapped_graph<int, int>(path).thaw() == numbers);
+			{
+				auto out = std::fstream(path, std::ios::binary | std::ios::in | std::ios::out);
+				out.seekp(position);
+				auto const bad = std::uint64_t{1} << 40U;
+				out.write(reinterpret_cast<char const*>(&bad), sizeof(bad));
+			}
+			CHECK_THROWS_WITH((gdwg::mapped_graph<int, int>(path)),
+			                  "Cannot call gdwg::mapped_graph<N, E>::mapped_graph on a corrupt file");
+			std::filesystem::remove(path);
+		}
+
+		auto const path = save(g, "gdwg_binary_pool.bin");
+		{
+			// The first node's end offset in the string pool, which starts after the header.
+			auto out = std::fstream(path, std::ios::binary | std::ios::in | std::ios::out);
+			out.seekp(56);
+			auto const bad = std::uint64_t{1} << 40U;
+			out.write(reinterpret_cast<char const*>(&bad), sizeof(bad));
+		}
+		CHECK_THROWS_WITH((gdwg::mapped_graph<std::string, int>(path)),
+		                  "Cannot call gdwg::mapped_graph<N, E>::mapped_graph on a corrupt file");
+		std::filesystem::remove(path);
+	}
+}
@@ -0,0 +1,102 @@
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+TEST_CASE("Bulk Load Constructor Tests") {
+	using graph = gdwg::graph<std::string, int>;
+
+	SECTION("Unsorted Input With Duplicates") {
+		auto const values = std::vector<graph::value_type>{
+		   {"how", "you?", 1},
+		   {"hello", "are", 8},
+		   {"are", "you?", 3},
+		   {"hello", "are", 2},
+		   {"how", "hello", 4},
+		   {"hello", "are", 8},
+		   {"you?", "you?", 5},
+		};
+		auto g = graph(values.begin(), values.end());
+		CHECK(g.nodes() == std::vector<std::string>{"are", "hello", "how", "you?"});
+		CHECK(g.weights("hello", "are") == std::vector<int>{2, 8});
+		CHECK(g.connections("how") == std::vector<std::string>{"hello", "you?"});
+		CHECK(g.is_connected("you?", "you?"));
+
+		auto count = 0;
+		for (auto const& [from, to, weight] : g) {
+			CHECK(g.find(from, to, weight) != g.end());
+			++count;
+		}
+		CHECK(count == 6);
+	}
+
+	SECTION("Matches Edge By Edge Insertion") {
+		auto values = std::vector<gdwg::graph<int, int>::value_type>();
+		for (auto i = 0; i < 500; ++i) {
+			values.push_back({(i * 37) % 101, (i * 53) % 97, i % 7});
+		}
+		auto expected = gdwg::graph<int, int>();
+		for (auto const& [from, to, weight] : values) {
+			expected.insert_node(from);
+			expected.insert_node(to);
+			expected.insert_edge(from, to, weight);
+		}
+		CHECK(gdwg::graph<int, int>(values.begin(), values.end()) == expected);
+		CHECK(gdwg::graph<int, int>(values.begin(), values.end(), gdwg::graph_storage::arena)
+		      == expected);
+	}
+
+	SECTION("Pre-Sorted Input") {
+		auto const values = std::vector<graph::value_type>{
+		   {"a", "b", 1},
+		   {"a", "b", 2},
+		   {"a", "c", 1},
+		   {"b", "a", 3},
+		   {"c", "c", 4},
+		};
+		auto g = graph(gdwg::sorted_unique, values.begin(), values.end());
+		CHECK(g.nodes() == std::vector<std::string>{"a", "b", "c"});
+		CHECK(g.weights("a", "b") == std::vector<int>{1, 2});
+		CHECK(g == graph(values.begin(), values.end()));
+	}
+
+	SECTION("Sorted Unique Promise Broken") {
+		auto const unsorted =
+		   std::vector<graph::value_type>{{"c", "a", 1}, {"a", "c", 2}, {"c", "a", 1}};
+		auto h = graph(gdwg::sorted_unique, unsorted.begin(), unsorted.end());
+		CHECK(h == graph(unsorted.begin(), unsorted.end()));
+
+		auto values = std::vector<gdwg::graph<int, int>::value_type>();
+		for (auto i = 0; i < 500; ++i) {
+			values.push_back({(i * 37) % 23, (i * 53) % 19, (i * 11) % 5});
+		}
+		auto const expected = gdwg::graph<int, int>(values.begin(), values.end());
+		auto const loaded = gdwg::graph<int, int>(gdwg::sorted_unique, values.begin(), values.end());
+		CHECK(loaded == expected);
+		for (auto const& [from, to, weight] : values) {
+			CHECK(loaded.find(from, to, weight) != loaded.end());
+		}
+		CHECK(gdwg::graph<int, int>(gdwg::sorted_unique,
+		                            values.begin(),
+		                            values.end(),
+		                            gdwg::graph_storage::arena)
+		      == expected);
+	}
+
+	SECTION("Reserve") {
+		auto arena = graph(gdwg::graph_storage::arena);
+		arena.reserve(1000);
+		CHECK(arena.storage() == gdwg::graph_storage::arena);
+		CHECK(arena.insert_node("a"));
+		CHECK(arena.insert_edge("a", "a", 1));
+		arena.reserve(10);
+		CHECK(arena.is_connected("a", "a"));
+
+		auto upstream = std::pmr::monotonic_buffer_resource();
+		auto g = graph(&upstream);
+		g.reserve(1000);
+		CHECK(g.resource() == &upstream);
+	}
+}
@@ -0,0 +1,160 @@
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+	// predecessors() and in_degree() worked out from the edges themselves.
+	template<typename N, typename E>
+	auto check_incoming(gdwg::graph<N, E> const& g) -> void {
+		for (auto const& dst : g.nodes()) {
+			auto expected = std::vector<N>();
+			auto degree = std::size_t{0};
+			for (auto const& [from, to, weight] : g) {
+				if (to == dst) {
+					if (expected.empty() || expected.back() != from) {
+						expected.push_back(from);
+					}
+					++degree;
+				}
+			}
+			CHECK(g.predecessors(dst) == expected);
+			CHECK(g.in_degree(dst) == degree);
+		}
+	}
+} // namespace
+
+TEST_CASE("Incoming Index Tests") {
+	auto g = gdwg::graph<std::string, int>(gdwg::incoming_index);
+	for (auto const* node : {"a", "b", "c", "d"}) {
+		g.insert_node(node);
+	}
+	g.insert_edge("a", "c", 1);
+	g.insert_edge("a", "c", 2);
+	g.insert_edge("b", "c", 3);
+	g.insert_edge("c", "c", 4);
+	g.insert_edge("c", "d", 5);
+	REQUIRE(g.has_incoming_index());
+
+	SECTION("Queries") {
+		CHECK(g.predecessors("c") == std::vector<std::string>{"a", "b", "c"});
+		CHECK(g.in_degree("c") == 4);
+		CHECK(g.predecessors("a").empty());
+		CHECK(g.in_degree("a") == 0);
+		CHECK_THROWS_WITH(g.predecessors("z"),
+		                  "Cannot call gdwg::graph<N, E>::predecessors if dst doesn't exist in the "
+		                  "graph");
+		CHECK_THROWS_WITH(g.in_degree("z"),
+		                  "Cannot call gdwg::graph<N, E>::in_degree if dst doesn't exist in the "
+		                  "graph");
+		check_incoming(g);
+	}
+
+	SECTION("Modifiers Keep The Index In Step") {
+		g.erase_edge("a", "c", 1);
+		CHECK(g.in_degree("c") == 3);
+		g.erase_edge("a", "c", 2);
+		CHECK(g.predecessors("c") == std::vector<std::string>{"b", "c"});
+		g.replace_node("c", "0");
+		CHECK(g.predecessors("0") == std::vector<std::string>{"0", "b"});
+		CHECK(g.predecessors("d") == std::vector<std::string>{"0"});
+		check_incoming(g);
+		g.merge_replace_node("0", "d");
+		CHECK(g.predecessors("d") == std::vector<std::string>{"b", "d"});
+		CHECK(g.in_degree("d") == 3);
+		check_incoming(g);
+		g.erase_edge(g.begin());
+		check_incoming(g);
+		g.erase_node("d");
+		CHECK(g.in_degree("b") == 0);
+		check_incoming(g);
+	}
+
+	SECTION("Copies Moves And Clear") {
+		auto copy = g;
+		CHECK(copy.has_incoming_index());
+		g.erase_node("c");
+		CHECK(copy.in_degree("c") == 4);
+		check_incoming(copy);
+
+		auto moved = std::move(copy);
+		CHECK(moved.has_incoming_index());
+		check_incoming(moved);
+		moved.clear();
+		moved.insert_node("x");
+		moved.insert_edge("x", "x", 1);
+		CHECK(moved.predecessors("x") == std::vector<std::string>{"x"});
+	}
+
+	SECTION("Graphs Without The Index Answer The Same") {
+		auto plain = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+		for (auto const& [from, to, weight] : g) {
+			plain.insert_edge(from, to, weight);
+		}
+		CHECK(!plain.has_incoming_index());
+		CHECK(plain.predecessors("c") == g.predecessors("c"));
+		CHECK(plain.in_degree("c") == g.in_degree("c"));
+	}
+
+	SECTION("Random Mutations Match A Graph Without The Index") {
+		using graph = gdwg::graph<int, int>;
+		for (auto storage : {gdwg::graph_storage::heap, gdwg::graph_storage::arena}) {
+			auto indexed = graph(gdwg::incoming_index, storage);
+			auto plain = graph();
+			auto engine = std::mt19937(3);
+			auto value = std::uniform_int_distribution<int>(0, 11);
+			for (auto round = 0; round < 2000; ++round) {
+				auto const src = value(engine);
+				auto const dst = value(engine);
+				auto const weight = value(engine) % 3;
+				auto const op = value(engine);
+				for (auto* h : {&indexed, &plain}) {
+					switch (op) {
+					case 0: h->erase_node(src); break;
+					case 1:
+						if (h->is_node(src)) {
+							h->replace_node(src, dst + 12);
+						}
+						break;
+					case 2:
+						if (h->is_node(src) && h->is_node(dst)) {
+							h->merge_replace_node(src, dst);
+						}
+						break;
+					case 3:
+						if (h->is_node(src) && h->is_node(dst)) {
+							h->erase_edge(src, dst, weight);
+						}
+						break;
+					case 4:
+						if (auto it = h->find(src, dst, weight); it != h->end()) {
+							h->erase_edge(it);
+						}
+						break;
+					case 5:
+						h->apply(std::vector{graph::mutation::insert_node(src),
+						                     graph::mutation::insert_node(dst),
+						                     graph::mutation::insert_edge(src, dst, weight),
+						                     graph::mutation::erase_node(weight)});
+						break;
+					default:
+						h->insert_node(src);
+						h->insert_node(dst);
+						h->insert_edge(src, dst, weight);
+						break;
+					}
+				}
+				REQUIRE(indexed == plain);
+				if (round % 50 == 0) {
+					check_incoming(indexed);
+					check_incoming(graph(indexed));
+				}
+			}
+			check_incoming(indexed);
+		}
+	}
+}
@@ -0,0 +1,107 @@
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+TEST_CASE("Merge Nodes Tests") {
+	using graph = gdwg::graph<int, int>;
+	auto g = graph{1, 2, 3, 4};
+	g.insert_edge(1, 2, 1);
+	g.insert_edge(1, 3, 1);
+	g.insert_edge(2, 3, 1);
+	g.insert_edge(3, 1, 2);
+	g.insert_edge(4, 4, 5);
+
+	SECTION("Colliding Weights Are Merged") {
+		auto expected = graph{3, 4};
+		expected.insert_edge(3, 3, 1);
+		expected.insert_edge(3, 3, 2);
+		expected.insert_edge(4, 4, 5);
+
+		auto indexed = graph(gdwg::incoming_index);
+		for (auto const& [from, to, weight] : g) {
+			indexed.insert_node(from);
+			indexed.insert_node(to);
+			indexed.insert_edge(from, to, weight);
+		}
+
+		auto const merges = std::vector<std::pair<int, int>>{{1, 2}, {2, 3}};
+		g.merge_nodes(merges);
+		indexed.merge_nodes(merges);
+		CHECK(g == expected);
+		CHECK(indexed == expected);
+		CHECK(indexed.predecessors(3) == std::vector<int>{3});
+		CHECK(indexed.in_degree(3) == 2);
+	}
+
+	SECTION("Merges Before A Failure Are Kept") {
+		auto const merges = std::vector<std::pair<int, int>>{{4, 4}, {2, 1}, {2, 3}};
+		CHECK_THROWS_WITH(g.merge_nodes(merges),
+		                  "Cannot call gdwg::graph<N, E>::merge_replace_node on old or new data if "
+		                  "they don't exist in the graph");
+		auto expected = graph{1, 3, 4};
+		expected.insert_edge(1, 1, 1);
+		expected.insert_edge(1, 3, 1);
+		expected.insert_edge(3, 1, 2);
+		expected.insert_edge(4, 4, 5);
+		CHECK(g == expected);
+	}
+
+	SECTION("Random Batches Match Merging One At A Time") {
+		auto engine = std::mt19937(5);
+		auto value = std::uniform_int_distribution<int>(0, 29);
+		for (auto round = 0; round < 100; ++round) {
+			auto sequential = graph();
+			for (auto node = 0; node < 30; ++node) {
+				sequential.insert_node(node);
+			}
+			for (auto edge = 0; edge < 80; ++edge) {
+				sequential.insert_edge(value(engine), value(engine), value(engine) % 4);
+			}
+			auto batched = sequential;
+			auto indexed = graph(gdwg::incoming_index);
+			indexed.merge_nodes({});
+			for (auto node = 0; node < 30; ++node) {
+				indexed.insert_node(node);
+			}
+			for (auto const& [from, to, weight] : sequential) {
+				indexed.insert_edge(from, to, weight);
+			}
+
+			// Valid merges between nodes still present, then now and again one that isn't.
+			auto present = sequential.nodes();
+			auto merges = std::vector<std::pair<int, int>>();
+			for (auto k = 0; k < 12; ++k) {
+				auto const old_data = present[static_cast<std::size_t>(value(engine)) % present.size()];
+				auto const new_data = present[static_cast<std::size_t>(value(engine)) % present.size()];
+				merges.emplace_back(old_data, new_data);
+				std::erase(present, old_data == new_data ? -1 : old_data);
+			}
+			if (round % 10 == 0) {
+				merges.insert(merges.begin() + 6, {value(engine), value(engine)});
+			}
+			auto threw = false;
+			try {
+				for (auto const& [old_data, new_data] : merges) {
+					sequential.merge_replace_node(old_data, new_data);
+				}
+			} catch (std::runtime_error const&) {
+				threw = true;
+			}
+			if (threw) {
+				CHECK_THROWS_AS(batched.merge_nodes(merges), std::runtime_error);
+				CHECK_THROWS_AS(indexed.merge_nodes(merges), std::runtime_error);
+			}
+			else {
+				batched.merge_nodes(merges);
+				indexed.merge_nodes(merges);
+			}
+			REQUIRE(batched == sequential);
+			REQUIRE(indexed == sequential);
+		}
+	}
+}
@@ -0,0 +1,206 @@
+#include "gdwg/graph.hpp"
+#include "gdwg/graph_algorithms.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+	// Every cached query from every node, against the same queries on a graph without a cache.
+	auto check_queries(gdwg::graph<int, int> const& g) -> void {
+		auto plain = g;
+		plain.disable_query_cache();
+		auto negative = false;
+		for (auto const& [from, to, weight] : plain) {
+			negative = negative || weight < 0;
+		}
+		for (auto const& node : plain.nodes_view()) {
+			CHECK(g.connections(node) == plain.connections(node));
+			CHECK(gdwg::bfs(g, node) == gdwg::bfs(plain, node));
+			CHECK(gdwg::dfs(g, node) == gdwg::dfs(plain, node));
+			if (negative) {
+				CHECK_THROWS_WITH(gdwg::dijkstra(g, node),
+				                  "Cannot call gdwg::dijkstra on a graph with negative edge weights");
+				continue;
+			}
+			auto const tree = gdwg::dijkstra(g, node);
+			auto const expected = gdwg::dijkstra(plain, node);
+			CHECK(tree.distance == expected.distance);
+			CHECK(tree.predecessor == expected.predecessor);
+		}
+	}
+} // namespace
+
+TEST_CASE("Query Cache Tests") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d", "e"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("b", "c", 2);
+	g.insert_edge("d", "e", 3);
+	g.enable_query_cache();
+	REQUIRE(g.has_query_cache());
+
+	SECTION("Version") {
+		auto const start = g.version();
+		CHECK(!g.insert_node("a"));
+		CHECK(!g.insert_edge("a", "b", 1));
+		CHECK(!g.erase_edge("a", "c", 1));
+		CHECK(g.version() == start);
+		CHECK(g.insert_node("f"));
+		CHECK(g.insert_edge("f", "a", 4));
+		CHECK(g.replace_node("f", "g"));
+		g.merge_replace_node("g", "e");
+		CHECK(g.erase_edge("e", "a", 4));
+		CHECK(g.erase_node("e"));
+		g.clear();
+		CHECK(g.version() == start + 7);
+	}
+
+	SECTION("Hits And Misses") {
+		CHECK(gdwg::bfs(g, "a") == std::vector<std::string>{"a", "b", "c"});
+		CHECK(gdwg::bfs(g, "a") == std::vector<std::string>{"a", "b", "c"});
+		CHECK(g.connections("d") == std::vector<std::string>{"e"});
+		CHECK(g.connections("d") == std::vector<std::string>{"e"});
+		CHECK(gdwg::dijkstra(g, "a").distance.at("c") == 3);
+		auto stats = g.cache_stats();
+		CHECK(stats.hits == 2);
+		CHECK(stats.misses == 3);
+		CHECK(stats.entries == 3);
+
+		// An edge out of a node none of them reached leaves them cached.
+		g.insert_node("f");
+		g.insert_edge("f", "d", 5);
+		CHECK(g.cache_stats().entries == 3);
+		CHECK(gdwg::bfs(g, "a").size() == 3);
+		CHECK(g.cache_stats().hits == 3);
+
+		// Only the searches from "a" reached "c".
+		g.insert_edge("c", "d", 1);
+		stats = g.cache_stats();
+		CHECK(stats.entries == 1);
+		CHECK(stats.invalidations == 2);
+		CHECK(gdwg::bfs(g, "a") == std::vector<std::string>{"a", "b", "c", "d", "e"});
+		CHECK(gdwg::dijkstra(g, "a").distance.at("e") == 7);
+
+		// Renaming a destination changes what connections() names.
+		g.replace_node("e", "0");
+		CHECK(g.connections("d") == std::vector<std::string>{"0"});
+		CHECK(gdwg::bfs(g, "a") == std::vector<std::string>{"a", "b", "c", "d", "0"});
+
+		CHECK_THROWS_WITH(gdwg::bfs(g, "x"),
+		                  "Cannot call gdwg::bfs if src doesn't exist in the graph");
+		g.clear();
+		CHECK(g.cache_stats().entries == 0);
+	}
+
+	SECTION("Copies Moves And Disabling") {
+		CHECK(gdwg::dfs(g, "a").size() == 3);
+		auto copy = g;
+		CHECK(copy.has_query_cache());
+		CHECK(copy.cache_stats().entries == 0);
+		auto moved = std::move(g);
+		CHECK(moved.cache_stats().entries == 1);
+		CHECK(gdwg::dfs(moved, "a").size() == 3);
+		CHECK(moved.cache_stats().hits == 1);
+		moved.disable_query_cache();
+		CHECK(!moved.has_query_cache());
+		CHECK(moved.cache_stats().hits == 0);
+		CHECK(gdwg::dfs(moved, "a").size() == 3);
+	}
+
+	SECTION("Random Mutations Never Leave A Stale Result") {
+		auto engine = std::mt19937(3);
+		auto value = std::uniform_int_distribution<int>(0, 9);
+		using graph = gdwg::graph<int, int>;
+		for (auto indexed : {graph(), graph(gdwg::incoming_index)}) {
+			indexed.enable_query_cache();
+			for (auto round = 0; round < 600; ++round) {
+				auto const src = value(engine);
+				auto const dst = value(engine);
+				auto const weight = value(engine) % 4 + 1;
+				switch (value(engine)) {
+				case 0: indexed.erase_node(src); break;
+				case 1:
+					if (indexed.is_node(src)) {
+						indexed.replace_node(src, dst + 10);
+					}
+					break;
+				case 2:
+					if (indexed.is_node(src) && indexed.is_node(dst)) {
+						indexed.merge_replace_node(src, dst);
+					}
+					break;
+				case 3:
+					if (indexed.is_node(src) && indexed.is_node(dst)) {
+						auto const merges = std::vector<std::pair<int, int>>{{src, dst}};
+						indexed.merge_nodes(merges);
+					}
+					break;
+				case 4:
+					if (auto it = indexed.find(src, dst, weight); it != indexed.end()) {
+						indexed.erase_edge(it);
+					}
+					break;
+				case 5:
+					indexed.apply(std::vector{graph::mutation::insert_node(src),
+					                          graph::mutation::insert_node(dst),
+					                          graph::mutation::insert_edge(src, dst, weight),
+					                          graph::mutation::erase_node(weight)});
+					break;
+				case 6:
+					// A negative edge that no search reaches, which still makes every cached dijkstra
+					// stale, as dijkstra refuses the whole graph. It is taken out again the next time.
+					if (indexed.is_node(20)) {
+						indexed.erase_node(20);
+					}
+					else {
+						indexed.insert_node(20);
+						indexed.insert_node(21);
+						indexed.insert_edge(20, 21, -1);
+					}
+					break;
+				default:
+					indexed.insert_node(src);
+					indexed.insert_node(dst);
+					indexed.insert_edge(src, dst, weight);
+					break;
+				}
+				if (round % 10 == 0) {
+					check_queries(indexed);
+				}
+			}
+			CHECK(indexed.cache_stats().hits > 0);
+		}
+	}
+
+	SECTION("Concurrent Queries") {
+		auto big = gdwg::graph<int, int>();
+		for (auto i = 0; i < 200; ++i) {
+			big.insert_node(i);
+		}
+		for (auto i = 0; i < 199; ++i) {
+			big.insert_edge(i, i + 1, 1);
+			big.insert_edge(i, (i * 7) % 200, 2);
+		}
+		big.enable_query_cache();
+		auto const expected = gdwg::bfs(big, 0);
+		auto workers = std::vector<std::thread>();
+		auto results = std::vector<std::size_t>(4);
+		for (auto t = std::size_t{0}; t < results.size(); ++t) {
+			workers.emplace_back([&big, &expected, &results, t] {
+				for (auto i = 0; i < 100; ++i) {
+					results[t] += gdwg::bfs(big, i % 10) == gdwg::bfs(big, i % 10) ? 1 : 0;
+					results[t] += gdwg::bfs(big, 0) == expected ? 1 : 0;
+				}
+			});
+		}
+		for (auto& worker : workers) {
+			worker.join();
+		}
+		CHECK(results == std::vector<std::size_t>(4, 200));
+	}
+}
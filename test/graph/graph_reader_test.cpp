@@ -0,0 +1,83 @@
+#include "gdwg/graph_reader.hpp"
+
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+TEST_CASE("Graph Reader Tests") {
+	auto const value_type_vector = std::vector<gdwg::graph<int, int>::value_type>{
+	   {4, 1, -4},
+	   {3, 2, 2},
+	   {2, 4, 2},
+	   {2, 1, 1},
+	   {6, 2, 5},
+	   {6, 3, 10},
+	   {1, 5, -1},
+	   {3, 6, -8},
+	   {4, 5, 3},
+	   {5, 2, 7},
+	};
+	auto numbers = gdwg::graph<int, int>(value_type_vector.begin(), value_type_vector.end());
+	numbers.insert_node(-7);
+
+	SECTION("Round Trip Through Operator<<") {
+		auto out = std::ostringstream();
+		out << numbers;
+		auto in = std::istringstream(out.str());
+		auto read = gdwg::graph<int, int>{100};
+		CHECK(in >> read);
+		CHECK(read == numbers);
+
+		auto words = gdwg::graph<std::string, std::string>{"hello", "how", "are", "you?", "a (b", ""};
+		words.insert_edge("hello", "how", "a | b");
+		words.insert_edge("hello", "how", "");
+		words.insert_edge("you?", "you?", "again");
+		words.insert_edge("", "", "");
+		auto words_out = std::ostringstream();
+		words_out << words;
+		auto words_in = std::istringstream(words_out.str());
+		auto words_read = gdwg::graph<std::string, std::string>();
+		CHECK(words_in >> words_read);
+		CHECK(words_read == words);
+	}
+
+	SECTION("Small Chunks And Batches") {
+		auto out = std::ostringstream();
+		out << numbers;
+		auto in = std::istringstream(out.str());
+		auto reports = std::vector<gdwg::graph_reader<int, int>::progress>();
+		auto read = gdwg::graph<int, int>();
+		gdwg::graph_reader<int, int>(in, 5, 3)
+		   .on_progress([&reports](auto const& progress) { reports.push_back(progress); })
+		   .read_into(read);
+		CHECK(read == numbers);
+		REQUIRE(reports.size() > 3);
+		CHECK(reports.back().bytes == out.str().size());
+		CHECK(reports.back().nodes == 7);
+		CHECK(reports.back().edges == 10);
+		for (auto i = std::size_t{1}; i < reports.size(); ++i) {
+			CHECK(reports[i - 1].edges <= reports[i].edges);
+		}
+	}
+
+	SECTION("Malformed Input") {
+		auto read = gdwg::graph<int, int>();
+		auto missing_close = std::istringstream("1 (\n  2 | 3\n");
+		CHECK_THROWS_WITH((gdwg::graph_reader<int, int>(missing_close).read_into(read)),
+		                  "Cannot read a gdwg::graph<N, E> from line 2: the last node is missing its "
+		                  "closing ')'");
+		auto bad_weight = std::istringstream("1 (\n  2 | 3\n  2 | x\n)\n");
+		CHECK_THROWS_WITH((gdwg::graph_reader<int, int>(bad_weight).read_into(read)),
+		                  "Cannot read a gdwg::graph<N, E> from line 3: the weight can't be parsed");
+		auto bad_header = std::istringstream("1\n");
+		CHECK_THROWS_WITH((gdwg::graph_reader<int, int>(bad_header).read_into(read)),
+		                  "Cannot read a gdwg::graph<N, E> from line 1: expected 'node ('");
+
+		auto bad_stream = std::istringstream("1 (\n  2 |\n)\n");
+		CHECK(!(bad_stream >> read));
+		CHECK(read.nodes().empty());
+	}
+}
@@ -0,0 +1,298 @@
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <compare>
+#include <ostream>
+#include <random>
+#include <range/v3/iterator/operations.hpp>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+	// An int that isn't arithmetic, so its graph keeps the plain tree adjacency to compare with.
+	struct boxed {
+		int value;
+
+		auto operator<=>(boxed const&) const = default;
+
+		friend auto operator<<(std::ostream& os, boxed const& b) -> std::ostream& {
+			return os << b.value;
+		}
+	};
+
+	// Comfortably more destinations than an adjacency needs before it keeps its columns.
+	constexpr auto hub_degree = 40;
+	static_assert(hub_degree > 2 * 16);
+
+	// Node 0 has an edge to every other node, a second one to each even node, and every odd node
+	// has an edge back.
+	template<typename N, typename E>
+	auto hub_graph() -> gdwg::graph<N, E> {
+		auto g = gdwg::graph<N, E>();
+		for (auto i = 0; i <= hub_degree; ++i) {
+			g.insert_node(N{i});
+		}
+		for (auto i = 1; i <= hub_degree; ++i) {
+			g.insert_edge(N{0}, N{i}, static_cast<E>(i));
+			if (i % 2 == 0) {
+				g.insert_edge(N{0}, N{i}, static_cast<E>(-i));
+			}
+			else {
+				g.insert_edge(N{i}, N{0}, static_cast<E>(i));
+			}
+		}
+		return g;
+	}
+
+	template<typename N, typename E>
+	auto edges(gdwg::graph<N, E> const& g) -> std::vector<std::tuple<N, N, E>> {
+		auto result = std::vector<std::tuple<N, N, E>>();
+		for (auto const& [from, to, weight] : g) {
+			result.emplace_back(from, to, weight);
+		}
+		return result;
+	}
+
+	template<typename N, typename E>
+	auto text(gdwg::graph<N, E> const& g) -> std::string {
+		auto out = std::ostringstream();
+		out << g;
+		return out.str();
+	}
+} // namespace
+
+static_assert(gdwg::detail::soa_layout<int, int>);
+static_assert(gdwg::detail::soa_layout<int, double>);
+static_assert(not gdwg::detail::soa_layout<std::string, int>);
+static_assert(not gdwg::detail::soa_layout<int, std::string>);
+static_assert(not gdwg::detail::soa_layout<boxed, int>);
+
+TEMPLATE_TEST_CASE("SoA Graph Tests", "[graph]", int, double) {
+	using E = TestType;
+	using graph = gdwg::graph<int, E>;
+	auto g = hub_graph<int, E>();
+	auto const reference = hub_graph<boxed, E>();
+
+	SECTION("Constructors Test") {
+		CHECK(graph().empty());
+		CHECK(graph{3, 1, 2}.nodes() == std::vector<int>{1, 2, 3});
+		auto values = std::vector<typename graph::value_type>();
+		for (auto const& [from, to, weight] : g) {
+			values.push_back({from, to, weight});
+		}
+		CHECK(edges(graph(values.begin(), values.end())) == edges(g));
+
+		auto copy = g;
+		CHECK(copy == g);
+		CHECK(copy.erase_edge(0, 5, E(5)));
+		CHECK(copy.erase_node(6));
+		CHECK(copy != g);
+		CHECK(g.is_connected(0, 5));
+		CHECK(g.weights(0, 6) == std::vector<E>{E(-6), E(6)});
+
+		auto moved = std::move(copy);
+		CHECK(!moved.is_connected(0, 5));
+		CHECK(!moved.is_node(6));
+		CHECK(moved.is_connected(0, 7));
+	}
+
+	SECTION("Insert Edge Test") {
+		CHECK(!g.insert_edge(0, 9, E(9)));
+		CHECK(g.insert_edge(0, 9, E(100)));
+		CHECK(g.weights(0, 9) == std::vector<E>{E(9), E(100)});
+		CHECK(g.insert_node(-1));
+		CHECK(g.insert_edge(0, -1, E(1)));
+		CHECK(g.connections(0).front() == -1);
+		CHECK_THROWS_WITH(g.insert_edge(0, 1000, E(1)),
+		                  "Cannot call gdwg::graph<N, E>::insert_edge when either src or dst node "
+		                  "does not exist");
+	}
+
+	SECTION("Replace Node Test") {
+		auto const weights = g.weights(0, 8);
+		CHECK(g.replace_node(8, 1000));
+		CHECK(!g.is_node(8));
+		CHECK(g.connections(0).back() == 1000);
+		CHECK(g.weights(0, 1000) == weights);
+		CHECK(g.find(0, 1000, E(8)) != g.end());
+		CHECK(g.find(0, 9, E(9)) != g.end());
+		CHECK(!g.replace_node(1000, 9));
+		CHECK_THROWS_WITH(g.replace_node(8, 1),
+		                  "Cannot call gdwg::graph<N, E>::replace_node on a node that doesn't exist");
+	}
+
+	SECTION("Merge Replace Node Test") {
+		g.merge_replace_node(3, 4);
+		CHECK(!g.is_node(3));
+		CHECK(g.weights(0, 4) == std::vector<E>{E(-4), E(3), E(4)});
+		CHECK(g.weights(4, 0) == std::vector<E>{E(3)});
+		CHECK(g.connections(0).size() == hub_degree - 1);
+		CHECK_THROWS_WITH(g.merge_replace_node(3, 4),
+		                  "Cannot call gdwg::graph<N, E>::merge_replace_node on old or new data if "
+		                  "they don't exist in the graph");
+	}
+
+	SECTION("Erase Node Test") {
+		// Down past the size at which the hub's adjacency drops its columns, and back up.
+		for (auto i = 1; i <= hub_degree; i += 2) {
+			CHECK(g.erase_node(i));
+		}
+		for (auto i = 2; i <= hub_degree; i += 2) {
+			CHECK(g.is_connected(0, i));
+			CHECK(g.weights(0, i) == std::vector<E>{E(-i), E(i)});
+		}
+		CHECK(g.connections(0).size() == hub_degree / 2);
+		for (auto i = 1; i <= hub_degree; i += 2) {
+			g.insert_node(i);
+			CHECK(g.insert_edge(0, i, E(i)));
+		}
+		for (auto i = 1; i <= hub_degree; ++i) {
+			CHECK(g.find(0, i, E(i)) != g.end());
+		}
+		CHECK(!g.erase_node(hub_degree + 1));
+	}
+
+	SECTION("Erase Edge Test") {
+		CHECK(g.erase_edge(0, 10, E(10)));
+		CHECK(!g.erase_edge(0, 10, E(10)));
+		CHECK(g.weights(0, 10) == std::vector<E>{E(-10)});
+		CHECK(g.erase_edge(0, 10, E(-10)));
+		CHECK(!g.is_connected(0, 10));
+		CHECK(g.is_connected(0, 11));
+		CHECK_THROWS_WITH(g.erase_edge(0, 1000, E(2)),
+		                  "Cannot call gdwg::graph<N, E>::erase_edge on src or dst if they don't "
+		                  "exist in the graph");
+	}
+
+	SECTION("Erase Edge Iterator Successor Test") {
+		auto expected = g;
+		// Erasing every other edge crosses weight, destination and source boundaries.
+		auto it = g.begin();
+		auto keep = true;
+		while (it != g.end()) {
+			if (keep) {
+				++it;
+			}
+			else {
+				auto const [from, to, weight] = *it;
+				auto next = ranges::next(expected.find(from, to, weight));
+				auto const next_value = next == expected.end() ? *it : *next;
+				expected.erase_edge(from, to, weight);
+				it = g.erase_edge(it);
+				if (it != g.end()) {
+					CHECK(*it == next_value);
+				}
+			}
+			keep = !keep;
+		}
+		CHECK(g == expected);
+		CHECK(g.erase_edge(g.begin(), g.end()) == g.end());
+		CHECK(g.connections(0).empty());
+	}
+
+	SECTION("Clear Test") {
+		g.clear();
+		CHECK(g.empty());
+		g.insert_node(0);
+		g.insert_node(1);
+		CHECK(g.insert_edge(0, 1, E(1)));
+		CHECK(g.is_connected(0, 1));
+	}
+
+	SECTION("Accessors Test") {
+		for (auto i = 1; i <= hub_degree; ++i) {
+			CHECK(g.is_connected(0, i));
+			CHECK(g.is_connected(i, 0) == (i % 2 == 1));
+			CHECK(g.find(0, i, E(i)) != g.end());
+			CHECK(g.find(0, i, E(i + 1)) == g.end());
+			auto const expected =
+			   i % 2 == 0 ? std::vector<E>{E(-i), E(i)} : std::vector<E>{E(i)};
+			CHECK(g.weights(0, i) == expected);
+		}
+		CHECK(g.find(0, 0, E(0)) == g.end());
+		CHECK(g.find(0, 1, E(1)) == g.begin());
+		CHECK(g.connections(0).size() == hub_degree);
+		CHECK_THROWS_WITH(g.is_connected(0, 1000),
+		                  "Cannot call gdwg::graph<N, E>::is_connected if src or dst node don't "
+		                  "exist in the graph");
+		CHECK_THROWS_WITH(g.weights(1000, 0),
+		                  "Cannot call gdwg::graph<N, E>::weights if src or dst node don't exist in "
+		                  "the graph");
+	}
+
+	SECTION("Iterator Tests") {
+		auto const forward = edges(g);
+		auto backward = std::vector<std::tuple<int, int, E>>();
+		for (auto it = g.end(); it != g.begin();) {
+			--it;
+			auto const [from, to, weight] = *it;
+			backward.emplace_back(from, to, weight);
+		}
+		std::reverse(backward.begin(), backward.end());
+		CHECK(forward.size() == hub_degree + hub_degree / 2 + hub_degree / 2);
+		CHECK(forward == backward);
+	}
+
+	SECTION("Extractor Test") {
+		CHECK(text(g) == text(reference));
+	}
+}
+
+TEMPLATE_TEST_CASE("SoA Graph Matches The Tree Layout", "[graph]", int, double) {
+	using E = TestType;
+	auto g = gdwg::graph<int, E>();
+	auto reference = gdwg::graph<boxed, E>();
+	auto rng = std::mt19937(6771);
+	// A few sources take most of the edges, so their adjacencies cross the column threshold back
+	// and forth.
+	auto node = std::uniform_int_distribution(0, 79);
+	auto hub = std::uniform_int_distribution(0, 2);
+	auto weight = std::uniform_int_distribution(0, 3);
+	auto operation = std::uniform_int_distribution(0, 19);
+
+	for (auto step = 0; step < 4000; ++step) {
+		auto const a = operation(rng) < 14 ? hub(rng) : node(rng);
+		auto const b = node(rng);
+		auto const w = static_cast<E>(weight(rng));
+		auto const both = g.is_node(a) and g.is_node(b);
+		switch (auto const op = operation(rng); op) {
+		case 0:
+		case 1:
+			CHECK(g.erase_node(b) == reference.erase_node(boxed{b}));
+			break;
+		case 2:
+			if (g.is_node(a) and !g.is_node(b)) {
+				CHECK(g.replace_node(a, b) == reference.replace_node(boxed{a}, boxed{b}));
+			}
+			break;
+		case 3:
+			if (both) {
+				g.merge_replace_node(b, a);
+				reference.merge_replace_node(boxed{b}, boxed{a});
+			}
+			break;
+		default:
+			g.insert_node(a);
+			g.insert_node(b);
+			reference.insert_node(boxed{a});
+			reference.insert_node(boxed{b});
+			if (op < 6) {
+				CHECK(g.erase_edge(a, b, w) == reference.erase_edge(boxed{a}, boxed{b}, w));
+			}
+			else {
+				CHECK(g.insert_edge(a, b, w) == reference.insert_edge(boxed{a}, boxed{b}, w));
+			}
+			break;
+		}
+		if (g.is_node(a) and g.is_node(b)) {
+			REQUIRE(g.is_connected(a, b) == reference.is_connected(boxed{a}, boxed{b}));
+			REQUIRE(g.weights(a, b) == reference.weights(boxed{a}, boxed{b}));
+			REQUIRE((g.find(a, b, w) == g.end())
+			        == (reference.find(boxed{a}, boxed{b}, w) == reference.end()));
+		}
+	}
+	CHECK(text(g) == text(reference));
+}
@@ -0,0 +1,209 @@
+// Counters are only kept when instrumentation is compiled in.
+#define GDWG_INSTRUMENTATION 1
+
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory_resource>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+	auto fill(gdwg::graph<int, int>& g, int size) -> void {
+		for (auto i = 0; i < size; ++i) {
+			g.insert_node(i);
+		}
+		for (auto i = 0; i < size; ++i) {
+			g.insert_edge(i, (i + 1) % size, i);
+		}
+	}
+} // namespace
+
+TEST_CASE("Graph Stats Tests") {
+	using op = gdwg::graph_operation;
+	static_assert(gdwg::instrumentation_enabled);
+
+	SECTION("Calls, Lookups And Allocations Are Counted") {
+		auto g = gdwg::graph<int, int>();
+		fill(g, 100);
+		auto const stats = g.stats();
+		CHECK(stats[op::insert_node].calls == 100);
+		CHECK(stats[op::insert_edge].calls == 100);
+		CHECK(stats[op::erase_node].calls == 0);
+		// insert_edge looks up both ends.
+		CHECK(stats.lookups == 200);
+		CHECK(stats.comparisons > 200);
+		// One tree node per node, per source and per (src, dst) pair; the weights stay inline.
+		CHECK(stats.allocations == 300);
+		CHECK(stats.deallocations == 0);
+		CHECK(stats.bytes_allocated > 300 * sizeof(int));
+
+		CHECK(g.is_node(3));
+		CHECK(g.find(3, 4, 3) != g.end());
+		CHECK(g.connections(3) == std::vector<int>{4});
+		auto const after = g.stats();
+		CHECK(after[op::is_node].calls == 1);
+		CHECK(after[op::find].calls == 1);
+		CHECK(after[op::connections].calls == 1);
+		CHECK(after.lookups == stats.lookups + 4);
+		CHECK(after.allocations == stats.allocations);
+	}
+
+	SECTION("Histograms Account For Every Call") {
+		auto g = gdwg::graph<int, int>();
+		fill(g, 50);
+		auto const histogram = g.stats()[op::insert_edge];
+		CHECK(std::accumulate(histogram.buckets.begin(), histogram.buckets.end(), std::uint64_t{0})
+		      == histogram.calls);
+		CHECK(histogram.total > std::chrono::nanoseconds(0));
+		CHECK(histogram.percentile(0.5) <= histogram.percentile(0.99));
+		CHECK(histogram.percentile(1.0) > std::chrono::nanoseconds(0));
+		CHECK(gdwg::latency_histogram().percentile(0.5) == std::chrono::nanoseconds(0));
+
+		using gdwg::latency_histogram;
+		CHECK(latency_histogram::bucket_for(std::chrono::nanoseconds(0)) == 0);
+		CHECK(latency_histogram::bucket_for(std::chrono::nanoseconds(1)) == 0);
+		CHECK(latency_histogram::bucket_for(std::chrono::nanoseconds(2)) == 1);
+		CHECK(latency_histogram::bucket_for(std::chrono::nanoseconds(1000)) == 9);
+		CHECK(latency_histogram::bucket_for(std::chrono::hours(1000))
+		      == latency_histogram::bucket_count - 1);
+	}
+
+	SECTION("Views, Iteration, Comparison And Output Are Counted") {
+		auto g = gdwg::graph<int, int>();
+		fill(g, 10);
+		auto const other = g;
+		g.reset_stats();
+		static_cast<void>(g.nodes_view());
+		static_cast<void>(g.weights_view(1, 2));
+		static_cast<void>(g.all_edges());
+		CHECK(g.begin() != g.end());
+		CHECK(g == other);
+		auto out = std::ostringstream();
+		out << g;
+		g.write_text(out, 1);
+		auto const stats = g.stats();
+		for (auto const operation : {op::nodes_view,
+		                             op::weights_view,
+		                             op::all_edges,
+		                             op::begin,
+		                             op::end,
+		                             op::equals,
+		                             op::output,
+		                             op::write_text})
+		{
+			CHECK(stats[operation].calls == 1);
+		}
+		// operator== walks both graphs through edges_view, but only the outermost call counts.
+		CHECK(stats[op::edges_view].calls == 0);
+	}
+
+	SECTION("Copies And Moves Are Counted") {
+		auto g = gdwg::graph<int, int>();
+		fill(g, 10);
+		auto copy = g;
+		CHECK(copy.stats()[op::copy_construct].calls == 1);
+		CHECK(g.stats()[op::copy_construct].calls == 0);
+
+		auto moved = std::move(copy);
+		CHECK(moved.stats()[op::move_construct].calls == 1);
+		CHECK(moved.stats()[op::copy_construct].calls == 1);
+
+		auto target = gdwg::graph<int, int>();
+		target = std::move(moved);
+		CHECK(target.stats()[op::move_assign].calls == 1);
+		CHECK(target.stats()[op::move_construct].calls == 1);
+
+		target = g;
+		CHECK(target.stats()[op::copy_construct].calls == 1);
+		CHECK(target.stats()[op::copy_assign].calls == 1);
+		CHECK(target.stats()[op::move_assign].calls == 0);
+	}
+
+	SECTION("Only The Outermost Call Is Counted") {
+		auto g = gdwg::graph<int, int>(gdwg::incoming_index);
+		fill(g, 10);
+		auto const merges = std::vector<std::pair<int, int>>{{1, 2}, {3, 4}};
+		g.merge_nodes(merges);
+		auto const stats = g.stats();
+		CHECK(stats[op::merge_nodes].calls == 1);
+		CHECK(stats[op::merge_replace_node].calls == 0);
+		CHECK(stats[op::is_node].calls == 0);
+	}
+
+	SECTION("Scans An Incoming Index Avoids Are Counted") {
+		auto plain = gdwg::graph<int, int>();
+		auto indexed = gdwg::graph<int, int>(gdwg::incoming_index);
+		fill(plain, 100);
+		fill(indexed, 100);
+		plain.reset_stats();
+		indexed.reset_stats();
+		CHECK(plain.erase_node(50));
+		CHECK(indexed.erase_node(50));
+		CHECK(plain.predecessors(60) == std::vector<int>{59});
+		CHECK(indexed.predecessors(60) == std::vector<int>{59});
+		CHECK(plain.stats().adjacency_scans > 150);
+		CHECK(indexed.stats().adjacency_scans == 0);
+	}
+
+	SECTION("Reset, Move And Copy") {
+		auto counter = std::pmr::monotonic_buffer_resource();
+		auto g = gdwg::graph<int, int>(&counter);
+		fill(g, 20);
+		CHECK(g.resource() == &counter);
+
+		auto moved = std::move(g);
+		CHECK(moved.stats()[op::insert_edge].calls == 20);
+		CHECK(moved.resource() == &counter);
+		CHECK(g.stats()[op::insert_edge].calls == 0);
+		g.insert_node(1);
+		CHECK(g.stats()[op::insert_node].calls == 1);
+
+		auto const copy = moved;
+		CHECK(copy.stats()[op::insert_edge].calls == 0);
+		CHECK(copy.stats().allocations > 0);
+
+		moved.reset_stats();
+		auto const reset = moved.stats();
+		CHECK(reset.allocations == 0);
+		CHECK(reset.comparisons == 0);
+		CHECK(reset[op::insert_edge].calls == 0);
+		CHECK(reset[op::insert_edge].total == std::chrono::nanoseconds(0));
+	}
+
+	SECTION("Arena Graphs Keep Counting Across Clear And Reserve") {
+		auto g = gdwg::graph<int, int>(gdwg::graph_storage::arena);
+		g.reserve(100);
+		fill(g, 10);
+		auto const allocations = g.stats().allocations;
+		CHECK(allocations == 30);
+		g.clear();
+		CHECK(g.stats()[op::clear].calls == 1);
+		fill(g, 10);
+		CHECK(g.stats().allocations == 2 * allocations);
+	}
+
+	SECTION("Concurrent Readers Are All Counted") {
+		auto g = gdwg::graph<int, int>();
+		fill(g, 100);
+		auto readers = std::vector<std::thread>();
+		for (auto t = 0; t < 4; ++t) {
+			readers.emplace_back([&g] {
+				for (auto i = 0; i < 1000; ++i) {
+					static_cast<void>(g.is_connected(i % 100, (i + 1) % 100));
+				}
+			});
+		}
+		for (auto& reader : readers) {
+			reader.join();
+		}
+		auto const stats = g.stats();
+		CHECK(stats[op::is_connected].calls == 4000);
+		CHECK(stats.lookups == 200 + 8000);
+	}
+}
@@ -0,0 +1,132 @@
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <iomanip>
+#include <ios>
+#include <limits>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+	struct point {
+		int x;
+		int y;
+		auto operator<=>(point const&) const = default;
+	};
+
+	auto operator<<(std::ostream& os, point const& p) -> std::ostream& {
+		return os << '<' << p.x << ',' << p.y << '>';
+	}
+
+	// The text written one value at a time straight to the stream.
+	template<typename N, typename E>
+	auto streamed(gdwg::graph<N, E> const& g, std::ostream& os) -> std::string {
+		auto edge = g.begin();
+		for (auto const& node : g.nodes_view()) {
+			os << node << " (\n";
+			for (; edge != g.end() && !(node < std::get<0>(*edge)); ++edge) {
+				os << "  " << std::get<1>(*edge) << " | " << std::get<2>(*edge) << "\n";
+			}
+			os << ")\n";
+		}
+		return static_cast<std::ostringstream&>(os).str();
+	}
+
+	// operator<< and write_text, on a stream prepared the same way as for the expected text.
+	template<typename N, typename E, typename Prepare>
+	auto check_text(gdwg::graph<N, E> const& g, Prepare prepare) -> void {
+		auto reference = std::ostringstream();
+		prepare(reference);
+		auto const expected = streamed(g, reference);
+		auto out = std::ostringstream();
+		prepare(out);
+		out << g;
+		CHECK(out.str() == expected);
+		for (auto const threads : std::vector<std::size_t>{0, 1, 2, 3, 8}) {
+			auto parallel = std::ostringstream();
+			prepare(parallel);
+			g.write_text(parallel, threads);
+			CHECK(parallel.str() == expected);
+		}
+	}
+
+	auto plain = [](std::ostream&) {};
+} // namespace
+
+TEST_CASE("Text Output Tests") {
+	SECTION("Exact Format") {
+		auto g = gdwg::graph<std::string, int>{"how", "are", "you?", "alone"};
+		g.insert_edge("how", "are", 5);
+		g.insert_edge("how", "you?", -3);
+		g.insert_edge("how", "you?", 10);
+		g.insert_edge("are", "how", 0);
+		auto out = std::ostringstream();
+		out << g;
+		CHECK(out.str()
+		      == "alone (\n"
+		         ")\n"
+		         "are (\n"
+		         "  how | 0\n"
+		         ")\n"
+		         "how (\n"
+		         "  are | 5\n"
+		         "  you? | -3\n"
+		         "  you? | 10\n"
+		         ")\n"
+		         "you? (\n"
+		         ")\n");
+		check_text(g, plain);
+		check_text(gdwg::graph<std::string, int>(), plain);
+	}
+
+	SECTION("Numbers Match The Stream") {
+		auto g = gdwg::graph<long, double>{-7, 0, 3, std::numeric_limits<long>::max()};
+		g.insert_edge(-7, 0, 0.1 + 0.2);
+		g.insert_edge(-7, 3, 1e20);
+		g.insert_edge(0, 0, -2.5e-7);
+		g.insert_edge(3, -7, 123456789.0);
+		g.insert_edge(3, -7, std::numeric_limits<double>::infinity());
+		g.insert_edge(std::numeric_limits<long>::max(), 3, 100.0);
+		check_text(g, plain);
+		check_text(g, [](std::ostream& os) { os << std::fixed << std::setprecision(2); });
+		check_text(g, [](std::ostream& os) { os << std::hex << std::showpos; });
+		check_text(g, [](std::ostream& os) { os << std::setw(9) << std::setfill('*'); });
+
+		auto floats = gdwg::graph<float, float>{1.0f / 3, 2.5f};
+		floats.insert_edge(1.0f / 3, 2.5f, 1e-3f);
+		check_text(floats, plain);
+	}
+
+	SECTION("Streamed Types") {
+		auto g = gdwg::graph<point, point>{{0, 0}, {1, -1}};
+		g.insert_edge({0, 0}, {1, -1}, {4, 4});
+		g.insert_edge({1, -1}, {1, -1}, {-2, 3});
+		check_text(g, plain);
+		check_text(g, [](std::ostream& os) { os << std::showpos; });
+
+		auto chars = gdwg::graph<char, bool>{'a', 'b'};
+		chars.insert_edge('a', 'b', true);
+		chars.insert_edge('b', 'a', false);
+		check_text(chars, plain);
+		check_text(chars, [](std::ostream& os) { os << std::boolalpha; });
+	}
+
+	SECTION("Many Blocks Keep Their Order") {
+		auto engine = std::mt19937(11);
+		auto node = std::uniform_int_distribution<int>(0, 4999);
+		auto g = gdwg::graph<int, int>();
+		for (auto i = 0; i < 5000; ++i) {
+			g.insert_node(i);
+		}
+		for (auto i = 0; i < 20000; ++i) {
+			g.insert_edge(node(engine), node(engine), node(engine));
+		}
+		check_text(g, plain);
+		check_text(g, [](std::ostream& os) { os << std::oct; });
+	}
+}
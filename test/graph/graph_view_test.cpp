@@ -0,0 +1,65 @@
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <memory_resource>
+#include <range/v3/algorithm/equal.hpp>
+#include <range/v3/view/filter.hpp>
+#include <range/v3/view/transform.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+TEST_CASE("Graph View Tests") {
+	auto const values = std::vector<gdwg::graph<std::string, int>::value_type>{
+	   {"hello", "are", 8},
+	   {"hello", "are", 2},
+	   {"how", "you?", 1},
+	   {"how", "hello", 4},
+	   {"are", "you?", 3},
+	};
+	auto arena = std::pmr::monotonic_buffer_resource();
+	auto g = gdwg::graph<std::string, int>(&arena);
+	for (auto const& [from, to, weight] : values) {
+		g.insert_node(from);
+		g.insert_node(to);
+		g.insert_edge(from, to, weight);
+	}
+
+	SECTION("Nodes View") {
+		CHECK(ranges::equal(g.nodes_view(), g.nodes()));
+		CHECK(&*g.nodes_view().begin() == &*g.nodes_view().begin());
+		auto lengths =
+		   g.nodes_view() | ranges::views::transform([](auto const& n) { return n.size(); });
+		CHECK(ranges::equal(lengths, std::vector<std::size_t>{3, 5, 3, 4}));
+	}
+
+	SECTION("Edges View") {
+		auto heavy = g.edges_view()
+		             | ranges::views::filter([](auto const& edge) { return std::get<2>(edge) > 3; });
+		auto heavy_weights = heavy | ranges::views::transform([](auto const& edge) {
+			                     return std::get<2>(edge);
+		                     });
+		CHECK(ranges::equal(heavy_weights, std::vector<int>{8, 4}));
+
+		auto count = 0;
+		for (auto const& [from, to, weight] : g.edges_view()) {
+			CHECK(g.find(from, to, weight) != g.end());
+			++count;
+		}
+		CHECK(count == 5);
+	}
+
+	SECTION("Weights View") {
+		CHECK(ranges::equal(g.weights_view("hello", std::string_view("are")), std::vector<int>{2, 8}));
+		CHECK(g.weights_view("are", "hello").empty());
+		CHECK_THROWS_WITH(g.weights_view("john", "smit"),
+		                  "Cannot call gdwg::graph<N, E>::weights_view if src or dst node don't "
+		                  "exist in the graph");
+	}
+
+	SECTION("Views Refer To Internal Storage") {
+		auto const* weight = &*g.weights_view("are", "you?").begin();
+		CHECK(&std::get<2>(*g.edges_view().begin()) == weight);
+		CHECK(&*g.nodes_view().begin() == &std::get<0>(*g.begin()));
+	}
+}
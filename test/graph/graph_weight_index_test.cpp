@@ -0,0 +1,217 @@
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <iterator>
+#include <random>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+	template<typename N, typename E>
+	using edge = std::tuple<N, N, E>;
+
+	template<typename Range>
+	auto to_edges(Range const& range) {
+		using N = std::remove_cvref_t<decltype(std::get<0>(*range.begin()))>;
+		using E = std::remove_cvref_t<decltype(std::get<2>(*range.begin()))>;
+		auto result = std::vector<edge<N, E>>();
+		for (auto const& [from, to, weight] : range) {
+			result.emplace_back(from, to, weight);
+		}
+		return result;
+	}
+
+	// Every edge, sorted by weight as the index orders them.
+	template<typename N, typename E>
+	auto by_weight(gdwg::graph<N, E> const& g) -> std::vector<edge<N, E>> {
+		auto result = std::vector<edge<N, E>>();
+		for (auto const& [from, to, weight] : g) {
+			result.emplace_back(from, to, weight);
+		}
+		std::stable_sort(result.begin(), result.end(), [](auto const& a, auto const& b) {
+			return std::get<2>(a) < std::get<2>(b);
+		});
+		return result;
+	}
+
+	// Both queries worked out from the edges themselves.
+	template<typename N, typename E>
+	auto check_weights(gdwg::graph<N, E> const& g) -> void {
+		auto const expected = by_weight(g);
+		auto const all = expected.size();
+		CHECK(to_edges(g.top_k_edges(all + 1, gdwg::weight_order::lightest)) == expected);
+		auto reversed = expected;
+		std::reverse(reversed.begin(), reversed.end());
+		CHECK(to_edges(g.top_k_edges(all)) == reversed);
+		if (!expected.empty()) {
+			auto const lo = std::get<2>(expected.front());
+			auto const hi = std::get<2>(expected[expected.size() / 2]);
+			auto within = std::vector<edge<N, E>>();
+			std::copy_if(expected.begin(), expected.end(), std::back_inserter(within), [&](auto e) {
+				return !(std::get<2>(e) < lo) && !(hi < std::get<2>(e));
+			});
+			CHECK(to_edges(g.edges_in_weight_range(lo, hi)) == within);
+		}
+	}
+} // namespace
+
+TEST_CASE("Weight Index Tests") {
+	auto g = gdwg::graph<std::string, int>(gdwg::weight_index);
+	for (auto const* node : {"a", "b", "c", "d"}) {
+		g.insert_node(node);
+	}
+	g.insert_edge("a", "c", 5);
+	g.insert_edge("a", "c", 2);
+	g.insert_edge("b", "c", 5);
+	g.insert_edge("c", "c", 4);
+	g.insert_edge("c", "d", 1);
+	g.insert_edge("a", "b", 5);
+	REQUIRE(g.has_weight_index());
+	REQUIRE(!g.has_incoming_index());
+
+	using edges = std::vector<edge<std::string, int>>;
+
+	SECTION("Queries") {
+		CHECK(to_edges(g.edges_in_weight_range(2, 4)) == edges{{"a", "c", 2}, {"c", "c", 4}});
+		CHECK(to_edges(g.edges_in_weight_range(5, 5))
+		      == edges{{"a", "b", 5}, {"a", "c", 5}, {"b", "c", 5}});
+		CHECK(g.edges_in_weight_range(6, 10).empty());
+		CHECK(g.edges_in_weight_range(4, 2).empty());
+		CHECK(to_edges(g.top_k_edges(2)) == edges{{"b", "c", 5}, {"a", "c", 5}});
+		CHECK(to_edges(g.top_k_edges(2, gdwg::weight_order::lightest))
+		      == edges{{"c", "d", 1}, {"a", "c", 2}});
+		CHECK(g.top_k_edges(0).empty());
+		CHECK(to_edges(g.top_k_edges(100)).size() == 6);
+
+		auto range = g.top_k_edges(3, gdwg::weight_order::lightest);
+		auto last = range.end();
+		--last;
+		CHECK(std::get<2>(*last) == 4);
+		--last;
+		CHECK(std::get<0>(*last) == "a");
+		check_weights(g);
+
+		auto plain = gdwg::graph<std::string, int>{"a"};
+		CHECK(!plain.has_weight_index());
+		CHECK_THROWS_WITH(plain.edges_in_weight_range(0, 1),
+		                  "Cannot call gdwg::graph<N, E>::edges_in_weight_range on a graph without a "
+		                  "weight index");
+		CHECK_THROWS_WITH(plain.top_k_edges(1),
+		                  "Cannot call gdwg::graph<N, E>::top_k_edges on a graph without a weight "
+		                  "index");
+	}
+
+	SECTION("Modifiers Keep The Index In Step") {
+		g.erase_edge("a", "c", 5);
+		CHECK(to_edges(g.edges_in_weight_range(5, 5)).size() == 2);
+		g.replace_node("c", "0");
+		CHECK(to_edges(g.edges_in_weight_range(5, 5)) == edges{{"a", "b", 5}, {"b", "0", 5}});
+		check_weights(g);
+		g.merge_replace_node("0", "d");
+		CHECK(to_edges(g.top_k_edges(3, gdwg::weight_order::lightest))
+		      == edges{{"d", "d", 1}, {"a", "d", 2}, {"d", "d", 4}});
+		check_weights(g);
+		g.erase_edge(g.begin());
+		check_weights(g);
+		g.erase_node("d");
+		CHECK(g.top_k_edges(10).empty());
+		check_weights(g);
+	}
+
+	SECTION("Copies Moves And Clear") {
+		auto copy = g;
+		CHECK(copy.has_weight_index());
+		g.erase_node("c");
+		CHECK(to_edges(copy.top_k_edges(10)).size() == 6);
+		check_weights(copy);
+
+		auto moved = std::move(copy);
+		CHECK(moved.has_weight_index());
+		check_weights(moved);
+		moved.clear();
+		CHECK(moved.top_k_edges(10).empty());
+		moved.insert_node("x");
+		moved.insert_edge("x", "x", 1);
+		CHECK(to_edges(moved.top_k_edges(1)) == edges{{"x", "x", 1}});
+	}
+
+	SECTION("Merging Nodes Drops Duplicate Entries") {
+		auto both = gdwg::graph<int, int>(gdwg::incoming_index, gdwg::weight_index);
+		auto plain = gdwg::graph<int, int>(gdwg::weight_index);
+		for (auto* h : {&both, &plain}) {
+			for (auto i = 0; i < 6; ++i) {
+				h->insert_node(i);
+			}
+			h->insert_edge(0, 1, 7);
+			h->insert_edge(2, 1, 7);
+			h->insert_edge(1, 0, 3);
+			h->insert_edge(3, 4, 7);
+			h->insert_edge(5, 4, 7);
+			auto const merges = std::vector<std::pair<int, int>>{{0, 2}, {3, 5}, {5, 1}};
+			h->merge_nodes(merges);
+			CHECK(to_edges(h->top_k_edges(10, gdwg::weight_order::lightest))
+			      == std::vector<edge<int, int>>{{1, 2, 3}, {1, 4, 7}, {2, 1, 7}});
+			check_weights(*h);
+		}
+	}
+
+	SECTION("Random Mutations Match A Sort Of The Edges") {
+		using graph = gdwg::graph<int, int>;
+		for (auto storage : {gdwg::graph_storage::heap, gdwg::graph_storage::arena}) {
+			for (auto indexed : {graph(gdwg::weight_index, storage),
+			                     graph(gdwg::incoming_index, gdwg::weight_index, storage)}) {
+				auto engine = std::mt19937(5);
+				auto value = std::uniform_int_distribution<int>(0, 11);
+				for (auto round = 0; round < 2000; ++round) {
+					auto const src = value(engine);
+					auto const dst = value(engine);
+					auto const weight = value(engine) % 4;
+					switch (value(engine)) {
+					case 0: indexed.erase_node(src); break;
+					case 1:
+						if (indexed.is_node(src)) {
+							indexed.replace_node(src, dst + 12);
+						}
+						break;
+					case 2:
+						if (indexed.is_node(src) && indexed.is_node(dst)) {
+							indexed.merge_replace_node(src, dst);
+						}
+						break;
+					case 3:
+						if (indexed.is_node(src) && indexed.is_node(dst)) {
+							indexed.erase_edge(src, dst, weight);
+						}
+						break;
+					case 4:
+						if (auto it = indexed.find(src, dst, weight); it != indexed.end()) {
+							indexed.erase_edge(it);
+						}
+						break;
+					case 5:
+						indexed.apply(std::vector{graph::mutation::insert_node(src),
+						                          graph::mutation::insert_node(dst),
+						                          graph::mutation::insert_edge(src, dst, weight),
+						                          graph::mutation::erase_node(weight)});
+						break;
+					default:
+						indexed.insert_node(src);
+						indexed.insert_node(dst);
+						indexed.insert_edge(src, dst, weight);
+						break;
+					}
+					if (round % 50 == 0) {
+						check_weights(indexed);
+						check_weights(graph(indexed));
+					}
+				}
+				check_weights(indexed);
+			}
+		}
+	}
+}
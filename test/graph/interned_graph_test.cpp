@@ -0,0 +1,122 @@
+#include "gdwg/interned_graph.hpp"
+
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST_CASE("Interned Graph Tests") {
+	auto const values = std::vector<gdwg::graph<std::string, int>::value_type>{
+	   {"hello", "are", 8},
+	   {"hello", "are", 2},
+	   {"how", "you?", 1},
+	   {"how", "hello", 4},
+	   {"are", "you?", 3},
+	};
+	auto const g = gdwg::graph<std::string, int>(values.begin(), values.end());
+	auto interned = gdwg::interned_graph<std::string, int>(g);
+
+	SECTION("Accessors Match The Source Graph") {
+		CHECK(interned.to_graph() == g);
+		CHECK(interned.nodes() == g.nodes());
+		CHECK(interned.is_connected("hello", "are"));
+		CHECK(!interned.is_connected("are", "hello"));
+		CHECK(interned.weights("hello", "are") == std::vector<int>{2, 8});
+		CHECK(interned.connections("how") == std::vector<std::string>{"hello", "you?"});
+		CHECK(interned.find("how", "hello", 4) != interned.end());
+		CHECK(interned.find("how", "hello", 5) == interned.end());
+		CHECK(interned.node(*interned.id("how")) == "how");
+		CHECK(!interned.id("who"));
+
+		auto const& [from, to, weight] = *interned.begin();
+		CHECK(from == "are");
+		CHECK(to == "you?");
+		CHECK(weight == 3);
+
+		auto out = std::ostringstream();
+		auto expected = std::ostringstream();
+		out << interned;
+		expected << g;
+		CHECK(out.str() == expected.str());
+	}
+
+	SECTION("Renaming Keeps The ID And Every Edge") {
+		auto const id = *interned.id("hello");
+		CHECK(interned.replace_node("hello", "a hello"));
+		CHECK(!interned.replace_node("how", "you?"));
+		CHECK(*interned.id("a hello") == id);
+		CHECK(!interned.is_node("hello"));
+		CHECK(interned.connections("how") == std::vector<std::string>{"a hello", "you?"});
+		CHECK(interned.weights("a hello", "are") == std::vector<int>{2, 8});
+	}
+
+	SECTION("Erased IDs Are Reused") {
+		auto const id = *interned.id("are");
+		CHECK(interned.erase_node("are"));
+		CHECK(!interned.erase_node("are"));
+		CHECK(interned.insert_node("new"));
+		CHECK(*interned.id("new") == id);
+		CHECK(interned.connections("hello").empty());
+		CHECK(interned.connections("new").empty());
+	}
+
+	SECTION("Errors") {
+		CHECK_THROWS_WITH(interned.insert_edge("hello", "who", 1),
+		                  "Cannot call gdwg::interned_graph<N, E>::insert_edge when either src or "
+		                  "dst node does not exist");
+		CHECK_THROWS_WITH(interned.replace_node("who", "hello"),
+		                  "Cannot call gdwg::interned_graph<N, E>::replace_node on a node that "
+		                  "doesn't exist");
+		CHECK_THROWS_AS(interned.connections("who"), std::runtime_error);
+	}
+
+	SECTION("Random Mutations Match graph") {
+		auto plain = gdwg::graph<std::string, int>();
+		auto mirror = gdwg::interned_graph<std::string, int>();
+		auto engine = std::mt19937(13);
+		auto value = std::uniform_int_distribution<int>(0, 9);
+		auto name = [&] { return std::string(static_cast<std::size_t>(value(engine)) + 1, 'n'); };
+		for (auto round = 0; round < 3000; ++round) {
+			auto const src = name();
+			auto const dst = name();
+			auto const weight = value(engine) % 3;
+			switch (value(engine)) {
+			case 0: CHECK(mirror.erase_node(src) == plain.erase_node(src)); break;
+			case 1:
+				if (plain.is_node(src)) {
+					CHECK(mirror.replace_node(src, dst + "x") == plain.replace_node(src, dst + "x"));
+				}
+				break;
+			case 2:
+				if (plain.is_node(src) && plain.is_node(dst)) {
+					mirror.merge_replace_node(src, dst);
+					plain.merge_replace_node(src, dst);
+				}
+				break;
+			case 3:
+				if (plain.is_node(src) && plain.is_node(dst)) {
+					CHECK(mirror.erase_edge(src, dst, weight) == plain.erase_edge(src, dst, weight));
+				}
+				break;
+			default:
+				CHECK(mirror.insert_node(src) == plain.insert_node(src));
+				mirror.insert_node(dst);
+				plain.insert_node(dst);
+				CHECK(mirror.insert_edge(src, dst, weight) == plain.insert_edge(src, dst, weight));
+				break;
+			}
+			REQUIRE(mirror.to_graph() == plain);
+		}
+		auto copy = mirror;
+		CHECK(copy == mirror);
+		CHECK(copy == gdwg::interned_graph<std::string, int>(plain));
+		if (!plain.empty()) {
+			copy.erase_node(plain.nodes().front());
+			CHECK(copy != mirror);
+		}
+	}
+}
@@ -10,6 +10,7 @@
 #include <memory>
 #include <range/v3/iterator/operations.hpp>
 #include <sstream>
+#include <string_view>
 #include <type_traits>
 
 TEST_CASE("Main Graph Tests") {
@@ -69,6 +70,28 @@ TEST_CASE("Main Graph Tests") {
 		CHECK(copy_constructor2 == list_constructor);
 	}
 
+	SECTION("Copy Is Independent Of Its Source Test") {
+		auto source = gdwg::graph<std::string, int>{"a", "b", "c"};
+		source.insert_edge("a", "b", 1);
+		source.insert_edge("a", "b", 2);
+		source.insert_edge("c", "c", 3);
+		auto copy = source;
+		CHECK(copy == source);
+		CHECK(copy.weights("a", "b") == std::vector<int>{1, 2});
+
+		source.replace_node("c", "d");
+		source.erase_node("a");
+		CHECK(copy.nodes() == std::vector<std::string>{"a", "b", "c"});
+		CHECK(copy.is_connected("c", "c"));
+		copy.insert_edge("b", "a", 4);
+		CHECK(copy.connections("b") == std::vector<std::string>{"a"});
+		CHECK(source.nodes() == std::vector<std::string>{"b", "d"});
+
+		auto assigned = gdwg::graph<std::string, int>{"z"};
+		assigned = copy;
+		CHECK(assigned == copy);
+	}
+
 	SECTION("Move Constructor Test") {
 		CHECK(move_constructor == move_constructor2);
 		CHECK(node_edge_it_constructor.nodes() == move_constructor2.nodes());
@@ -236,10 +259,68 @@ TEST_CASE("Main Graph Tests") {
 		CHECK(erase_edge_it_range_graph.connections("D").empty());
 	}
 
+	SECTION("Erase Edge Iterator Successor Test") {
+		auto successor_graph = gdwg::graph<int, int>(value_type_vector.begin(), value_type_vector.end());
+		auto expected = gdwg::graph<int, int>(value_type_vector.begin(), value_type_vector.end());
+		// Erasing every other edge crosses weight, destination and source boundaries.
+		auto it = successor_graph.begin();
+		auto keep = true;
+		while (it != successor_graph.end()) {
+			if (keep) {
+				++it;
+			}
+			else {
+				auto const [from, to, weight] = *it;
+				auto next = ranges::next(expected.find(from, to, weight));
+				auto const next_value = next == expected.end() ? *it : *next;
+				expected.erase_edge(from, to, weight);
+				it = successor_graph.erase_edge(it);
+				if (it != successor_graph.end()) {
+					CHECK(*it == next_value);
+				}
+			}
+			keep = !keep;
+		}
+		CHECK(successor_graph == expected);
+
+		auto middle = ranges::next(successor_graph.begin(), 2);
+		CHECK(successor_graph.erase_edge(middle, successor_graph.end()) == successor_graph.end());
+		CHECK(ranges::distance(successor_graph.begin(), successor_graph.end()) == 2);
+		auto reverse = successor_graph.end();
+		--reverse;
+		CHECK(successor_graph.erase_edge(reverse) == successor_graph.end());
+		CHECK(successor_graph.erase_edge(successor_graph.begin()) == successor_graph.end());
+		CHECK(successor_graph.begin() == successor_graph.end());
+	}
+
 	SECTION("Clear Test") {
 		CHECK(clear_graph.empty());
 	}
 
+	auto self_loop_list = std::vector<gdwg::graph<std::string, int>::value_type>{
+	   {"A", "A", 1},
+	   {"A", "C", 2},
+	   {"C", "A", 3},
+	   {"B", "A", 4},
+	   {"B", "B", 4},
+	};
+	auto self_loop_graph =
+	   gdwg::graph<std::string, int>(self_loop_list.begin(), self_loop_list.end());
+	SECTION("Self Loop Replace And Merge Test") {
+		auto replaced = self_loop_graph;
+		CHECK(replaced.replace_node("A", "Z"));
+		CHECK(replaced.connections("Z") == std::vector<std::string>{"C", "Z"});
+		CHECK(replaced.connections("B") == std::vector<std::string>{"B", "Z"});
+		CHECK(replaced.weights("C", "Z") == std::vector<int>{3});
+
+		auto merged = self_loop_graph;
+		merged.merge_replace_node("A", "B");
+		CHECK(merged.nodes() == std::vector<std::string>{"B", "C"});
+		CHECK(merged.connections("B") == std::vector<std::string>{"B", "C"});
+		CHECK(merged.weights("B", "B") == std::vector<int>{1, 4});
+		CHECK(merged.weights("C", "B") == std::vector<int>{3});
+	}
+
 	// ======================================
 	//              Accessors
 	// ======================================
@@ -251,6 +332,22 @@ TEST_CASE("Main Graph Tests") {
 		CHECK(!is_node_graph.is_node("Z"));
 	}
 
+	auto heterogeneous_graph =
+	   gdwg::graph<std::string, int>(insert_values.begin(), insert_values.end());
+	SECTION("Heterogeneous Lookup Test") {
+		auto const hello = std::string_view("hello");
+		CHECK(heterogeneous_graph.is_node(hello));
+		CHECK(!heterogeneous_graph.is_node(std::string_view("hell")));
+		CHECK(heterogeneous_graph.is_connected(hello, "are"));
+		CHECK(heterogeneous_graph.weights(hello, std::string_view("are")) == std::vector<int>{2, 8});
+		CHECK(heterogeneous_graph.connections(std::string_view("how"))
+		      == std::vector<std::string>{"hello", "you?"});
+		CHECK(heterogeneous_graph.find(hello, "are", 8) != heterogeneous_graph.end());
+		CHECK(heterogeneous_graph.erase_edge(hello, "are", 8));
+		CHECK(heterogeneous_graph.erase_node(std::string_view("are")));
+		CHECK(heterogeneous_graph.nodes() == std::vector<std::string>{"hello", "how", "you?"});
+	}
+
 	auto empty_test_graph = empty_constructor;
 	auto not_empty_graph = is_node_graph;
 	SECTION("Empty Test") {
@@ -311,6 +408,18 @@ TEST_CASE("Main Graph Tests") {
 		CHECK(*last_it == end_values);
 		last_it++;
 		CHECK(last_it == range_test_graph.end());
+		auto forward = std::vector<ranges::common_tuple<std::string, std::string, int>>();
+		for (auto it = range_test_graph.begin(); it != range_test_graph.end(); ++it) {
+			forward.emplace_back(*it);
+		}
+		auto backward = std::vector<ranges::common_tuple<std::string, std::string, int>>();
+		for (auto it = range_test_graph.end(); it != range_test_graph.begin();) {
+			--it;
+			backward.emplace_back(*it);
+		}
+		std::reverse(backward.begin(), backward.end());
+		CHECK(forward.size() == 5);
+		CHECK(forward == backward);
 	}
 
 	// ======================================
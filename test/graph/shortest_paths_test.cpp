@@ -0,0 +1,154 @@
+#include "gdwg/shortest_paths.hpp"
+
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+TEST_CASE("Shortest Path Tests") {
+	auto const value_type_vector = std::vector<gdwg::graph<int, int>::value_type>{
+	   {4, 1, -4},
+	   {3, 2, 2},
+	   {2, 4, 2},
+	   {2, 1, 1},
+	   {6, 2, 5},
+	   {6, 3, 10},
+	   {1, 5, -1},
+	   {3, 6, -8},
+	   {4, 5, 3},
+	   {5, 2, 7},
+	};
+	auto const negative_graph =
+	   gdwg::graph<int, int>(value_type_vector.begin(), value_type_vector.end());
+
+	SECTION("Bellman-Ford With Negative Weights") {
+		auto const tree = gdwg::bellman_ford(negative_graph, 3);
+		CHECK(tree.distance
+		      == std::map<int, int>{{1, -5}, {2, -3}, {3, 0}, {4, -1}, {5, -6}, {6, -8}});
+		CHECK(tree.predecessor == std::map<int, int>{{1, 4}, {2, 6}, {4, 2}, {5, 1}, {6, 3}});
+
+		auto const from_five = gdwg::bellman_ford(negative_graph, 5);
+		CHECK(!from_five.distance.contains(3));
+		CHECK(!from_five.distance.contains(6));
+		CHECK(from_five.distance.at(1) == 5);
+	}
+
+	SECTION("Negative Weights And Cycles Are Rejected") {
+		CHECK_THROWS_WITH(gdwg::dijkstra(negative_graph, 3),
+		                  "Cannot call gdwg::dijkstra on a graph with negative edge weights");
+		CHECK_THROWS_WITH(gdwg::delta_stepping(negative_graph, 3, 4),
+		                  "Cannot call gdwg::delta_stepping on a graph with negative edge weights");
+
+		auto cycle = negative_graph;
+		cycle.insert_edge(5, 4, -3);
+		CHECK_THROWS_WITH(gdwg::bellman_ford(cycle, 3),
+		                  "Cannot call gdwg::bellman_ford on a graph with a negative cycle reachable "
+		                  "from src");
+	}
+
+	SECTION("Missing Nodes") {
+		CHECK_THROWS_WITH(gdwg::dijkstra(negative_graph, 7),
+		                  "Cannot call gdwg::dijkstra if src doesn't exist in the graph");
+		CHECK_THROWS_WITH(gdwg::dijkstra(negative_graph, 1, 7),
+		                  "Cannot call gdwg::dijkstra if src or dst node don't exist in the graph");
+		CHECK_THROWS_WITH(gdwg::bellman_ford(negative_graph, 7),
+		                  "Cannot call gdwg::bellman_ford if src doesn't exist in the graph");
+		CHECK_THROWS_WITH(gdwg::delta_stepping(negative_graph, 7, 1),
+		                  "Cannot call gdwg::delta_stepping if src doesn't exist in the graph");
+	}
+
+	SECTION("Parallel Edges And Heterogeneous Lookup") {
+		auto g = gdwg::graph<std::string, double>{"a", "b", "c"};
+		g.insert_edge("a", "b", 5.0);
+		g.insert_edge("a", "b", 1.5);
+		g.insert_edge("b", "c", 2.0);
+		g.insert_edge("a", "c", 4.0);
+		auto const tree = gdwg::dijkstra(g, std::string_view("a"));
+		CHECK(tree.distance.at("c") == 3.5);
+		CHECK(tree.predecessor.at("c") == "b");
+		CHECK(!tree.predecessor.contains("a"));
+		CHECK(gdwg::delta_stepping(g, "a", 1.0).distance == tree.distance);
+	}
+
+	SECTION("All Algorithms Agree On A Large Graph") {
+		auto engine = std::mt19937(6771);
+		auto node = std::uniform_int_distribution<int>(0, 4999);
+		auto weight = std::uniform_int_distribution<int>(0, 100);
+		auto values = std::vector<gdwg::graph<int, int>::value_type>();
+		for (auto i = 0; i < 40000; ++i) {
+			values.push_back({node(engine), node(engine), weight(engine)});
+		}
+		auto const g = gdwg::graph<int, int>(values.begin(), values.end());
+		auto const expected = gdwg::dijkstra(g, values.front().from);
+		CHECK(expected.distance.size() > 4000);
+		CHECK(gdwg::bellman_ford(g, values.front().from).distance == expected.distance);
+		for (auto delta : {1, 25, 1000}) {
+			auto const tree = gdwg::delta_stepping(g, values.front().from, delta);
+			CHECK(tree.distance == expected.distance);
+			// Every predecessor lies on a shortest path.
+			for (auto const& [to, from] : tree.predecessor) {
+				auto const weights = g.weights_view(from, to);
+				CHECK(tree.distance.at(from) + *weights.begin() == tree.distance.at(to));
+			}
+		}
+	}
+
+	SECTION("Large Weights And Path Lengths That Overflow") {
+		// One bucket per delta of distance would mean two billion of them here.
+		auto g = gdwg::graph<int, int>{1, 2, 3, 4};
+		g.insert_edge(1, 2, 1'000'000'000);
+		g.insert_edge(2, 3, 1'000'000'000);
+		CHECK(gdwg::delta_stepping(g, 1, 1).distance.at(3) == 2'000'000'000);
+		CHECK(gdwg::delta_stepping(g, 1, 3, 1).distance.at(3) == 2'000'000'000);
+		auto far = gdwg::graph<int, double>{1, 2};
+		far.insert_edge(1, 2, 1e300);
+		CHECK(gdwg::delta_stepping(far, 1, 1e-3).distance.at(2) == 1e300);
+
+		g.insert_edge(3, 4, 1'000'000'000);
+		CHECK_THROWS_WITH(gdwg::dijkstra(g, 1),
+		                  "Cannot call gdwg::dijkstra when a path length overflows the weight type");
+		CHECK_THROWS_WITH(gdwg::bellman_ford(g, 1),
+		                  "Cannot call gdwg::bellman_ford when a path length overflows the weight "
+		                  "type");
+		CHECK_THROWS_WITH(gdwg::delta_stepping(g, 1, 1),
+		                  "Cannot call gdwg::delta_stepping when a path length overflows the weight "
+		                  "type");
+		CHECK(gdwg::dijkstra(g, 1, 3).distance.at(3) == 2'000'000'000);
+	}
+
+	SECTION("Early Exit At A Target") {
+		auto g = gdwg::graph<int, int>{1, 2, 3, 4};
+		g.insert_edge(1, 2, 1);
+		g.insert_edge(2, 3, 1);
+		g.insert_edge(3, 4, 100);
+		auto const tree = gdwg::dijkstra(g, 1, 3);
+		CHECK(tree.distance == std::map<int, int>{{1, 0}, {2, 1}, {3, 2}});
+		auto const stepped = gdwg::delta_stepping(g, 1, 3, 5);
+		CHECK(stepped.distance == std::map<int, int>{{1, 0}, {2, 1}, {3, 2}});
+		CHECK(gdwg::delta_stepping(g, 1, 5).distance.at(4) == 102);
+	}
+
+	SECTION("Early Exit Answered From The Query Cache") {
+		auto g = gdwg::graph<int, int>{1, 2, 3, 4};
+		g.insert_edge(1, 2, 1);
+		g.insert_edge(2, 3, 1);
+		g.insert_edge(3, 4, 100);
+		g.enable_query_cache();
+		auto const full = gdwg::dijkstra(g, 1);
+		auto const hits = g.cache_stats().hits;
+		CHECK(gdwg::dijkstra(g, 1, 3).distance == full.distance);
+		CHECK(gdwg::delta_stepping(g, 1, 3, 5).distance == full.distance);
+		CHECK(g.cache_stats().hits == hits + 2);
+		CHECK_THROWS_WITH(gdwg::dijkstra(g, 1, 7),
+		                  "Cannot call gdwg::dijkstra if src or dst node don't exist in the graph");
+		CHECK_THROWS_WITH(gdwg::delta_stepping(g, 1, 3, 0),
+		                  "Cannot call gdwg::delta_stepping with a delta that isn't positive");
+
+		g.insert_edge(1, 3, 1);
+		CHECK(gdwg::dijkstra(g, 1, 3).distance.at(3) == 1);
+	}
+}
@@ -0,0 +1,100 @@
+#include "gdwg/simd_search.hpp"
+
+#include "gdwg/frozen_graph.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace {
+	// Sorted values with plenty of repeats, plus the extremes of T, which are the values a biased
+	// comparison of unsigned lanes would get wrong.
+	template<typename T>
+	auto sorted_values(std::mt19937& engine, std::size_t size) -> std::vector<T> {
+		auto values = std::vector<T>();
+		auto pick = std::uniform_int_distribution<int>(-50, 50);
+		for (auto i = std::size_t{0}; i < size; ++i) {
+			switch (i % 7) {
+			case 0: values.push_back(std::numeric_limits<T>::lowest()); break;
+			case 1: values.push_back(std::numeric_limits<T>::max()); break;
+			default: values.push_back(static_cast<T>(pick(engine))); break;
+			}
+		}
+		std::sort(values.begin(), values.end());
+		return values;
+	}
+
+	template<typename T>
+	auto check_against_std() -> void {
+		auto engine = std::mt19937(9173);
+		for (auto size = std::size_t{0}; size < 300; size += 1 + size / 8) {
+			auto const values = sorted_values<T>(engine, size);
+			auto probes = values;
+			probes.push_back(std::numeric_limits<T>::lowest());
+			probes.push_back(std::numeric_limits<T>::max());
+			probes.push_back(T{0});
+			probes.push_back(static_cast<T>(7));
+			for (auto const probe : probes) {
+				auto const* first = values.data();
+				auto const* last = first + values.size();
+				auto const expected = std::lower_bound(first, last, probe);
+				CHECK(gdwg::detail::simd_lower_bound(first, last, probe) == expected);
+				CHECK(gdwg::detail::count_below(first, values.size(), probe)
+				      == static_cast<std::size_t>(expected - first));
+			}
+		}
+	}
+} // namespace
+
+TEST_CASE("SIMD Search Tests") {
+	SECTION("Every Lane Type Agrees With std::lower_bound") {
+		check_against_std<std::int32_t>();
+		check_against_std<std::uint32_t>();
+		check_against_std<std::int64_t>();
+		check_against_std<std::uint64_t>();
+		check_against_std<float>();
+		check_against_std<double>();
+		check_against_std<std::int16_t>();
+		check_against_std<unsigned char>();
+	}
+
+	SECTION("Counting Doesn't Need A Sorted Range") {
+		auto const values = std::vector<int>{5, -3, 9, 0, 5, 12, -8, 1, 4, 4, 7, -1, 2};
+		CHECK(gdwg::detail::count_below(values.data(), values.size(), 4) == 6);
+		CHECK(gdwg::detail::count_below(values.data(), values.size(), -100) == 0);
+		CHECK(gdwg::detail::count_below(values.data(), 0, 100) == 0);
+	}
+
+	SECTION("Frozen Graphs Search Their Arrays") {
+		auto g = gdwg::graph<std::int64_t, double>();
+		for (auto i = std::int64_t{0}; i < 200; ++i) {
+			g.insert_node(i * 3);
+		}
+		for (auto i = std::int64_t{0}; i < 200; ++i) {
+			for (auto j = std::int64_t{0}; j < 200; j += 1 + i % 5) {
+				g.insert_edge(i * 3, j * 3, static_cast<double>(j) / 2);
+				g.insert_edge(i * 3, j * 3, -static_cast<double>(i));
+			}
+		}
+		auto const frozen = gdwg::frozen_graph(g);
+		for (auto i = std::int64_t{0}; i < 200; i += 7) {
+			CHECK(frozen.is_node(i * 3));
+			CHECK(!frozen.is_node(i * 3 + 1));
+			for (auto j = std::int64_t{0}; j < 200; j += 3) {
+				CHECK(frozen.is_connected(i * 3, j * 3) == g.is_connected(i * 3, j * 3));
+				CHECK(frozen.weights(i * 3, j * 3) == g.weights(i * 3, j * 3));
+				auto const weight = static_cast<double>(j) / 2;
+				CHECK((frozen.find(i * 3, j * 3, weight) == frozen.end())
+				      == (g.find(i * 3, j * 3, weight) == g.end()));
+			}
+		}
+		CHECK(frozen.find(0, 3, 0.25) == frozen.end());
+		CHECK(std::get<2>(*frozen.find(3, 0, -1.0)) == -1.0);
+	}
+}
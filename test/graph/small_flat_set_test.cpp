@@ -0,0 +1,97 @@
+#include "gdwg/small_flat_set.hpp"
+
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+#include <memory_resource>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+	template<typename T, std::size_t Inline>
+	auto contents(gdwg::detail::small_flat_set<T, Inline> const& s) -> std::vector<T> {
+		return {s.begin(), s.end()};
+	}
+} // namespace
+
+TEST_CASE("Small Flat Set Tests") {
+	using set = gdwg::detail::small_flat_set<std::string, 2>;
+	auto const long_string = std::string("a string too long for the small string optimisation");
+
+	SECTION("Stays Sorted And Unique Across The Spill") {
+		auto s = set();
+		CHECK(s.insert("b").second);
+		CHECK(s.insert(long_string).second);
+		CHECK(!s.insert("b").second);
+		CHECK(s.insert("c").second);
+		CHECK(*s.insert(s.end(), "d") == "d");
+		CHECK(*s.insert(s.begin(), "0") == "0");
+		CHECK(contents(s) == std::vector<std::string>{"0", long_string, "b", "c", "d"});
+		CHECK(s.erase("b") == 1);
+		CHECK(s.erase("b") == 0);
+		CHECK(*s.erase(s.begin()) == long_string);
+		CHECK(s.contains("c"));
+		CHECK(s.find("z") == s.end());
+		CHECK(contents(s) == std::vector<std::string>{long_string, "c", "d"});
+	}
+
+	SECTION("Merge Leaves Duplicates Behind") {
+		auto a = set();
+		auto b = set();
+		for (auto const* value : {"a", "c", "e"}) {
+			a.insert(value);
+		}
+		for (auto const* value : {"b", "c", "f"}) {
+			b.insert(value);
+		}
+		a.merge(b);
+		CHECK(contents(a) == std::vector<std::string>{"a", "b", "c", "e", "f"});
+		CHECK(contents(b) == std::vector<std::string>{"c"});
+	}
+
+	SECTION("Copies And Moves Across Resources") {
+		auto pool = std::pmr::unsynchronized_pool_resource();
+		auto a = set(&pool);
+		for (auto const* value : {"x", "y", "z"}) {
+			a.insert(value);
+		}
+		auto copy = set(a, std::pmr::get_default_resource());
+		CHECK(contents(copy) == contents(a));
+		auto moved = set(std::move(copy), &pool);
+		CHECK(contents(moved) == contents(a));
+		moved = a;
+		moved = set(&pool);
+		CHECK(moved.empty());
+		moved = std::move(a);
+		CHECK(contents(moved) == std::vector<std::string>{"x", "y", "z"});
+	}
+
+	SECTION("Random Operations Match std::set") {
+		auto engine = std::mt19937(9);
+		auto value = std::uniform_int_distribution<int>(0, 15);
+		auto s = gdwg::detail::small_flat_set<int>();
+		auto expected = std::set<int>();
+		for (auto round = 0; round < 5000; ++round) {
+			auto const v = value(engine);
+			switch (value(engine) % 3) {
+			case 0: CHECK(s.insert(v).second == expected.insert(v).second); break;
+			case 1: CHECK(s.erase(v) == expected.erase(v)); break;
+			default: s.insert(s.lower_bound(v), v); expected.insert(v); break;
+			}
+			REQUIRE(contents(s) == std::vector<int>(expected.begin(), expected.end()));
+		}
+	}
+
+	SECTION("Graphs Keep Weight Order And Uniqueness") {
+		auto g = gdwg::graph<std::string, std::string>{"a", "b"};
+		for (auto const* weight : {"w3", "w1", "w2", "w1", "w0"}) {
+			g.insert_edge("a", "b", weight);
+		}
+		CHECK(g.weights("a", "b") == std::vector<std::string>{"w0", "w1", "w2", "w3"});
+		CHECK(g.erase_edge("a", "b", "w2"));
+		auto it = g.find("a", "b", "w1");
+		CHECK(std::get<2>(*g.erase_edge(it)) == "w3");
+	}
+}